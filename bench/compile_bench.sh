@@ -0,0 +1,117 @@
+#!/bin/sh
+set -e
+
+# Measures the compile-time cost of mock-heavy translation units.
+#
+# For each method count, a translation unit declaring that many mock methods (spread across mock
+# classes of ten methods each) is generated and compiled. Signatures cycle through a mix of common
+# types and a value type unique to each class (written as `@` below), so the number of distinct
+# method<> instantiations grows with the number of classes, as it does in a real test suite. The
+# preprocessing time, compile time, object size and number of defined symbols are reported for
+# each count. Set COMPILE_BENCH_FORM to choose which mock macros are generated.
+#
+# Usage: compile_bench.sh <compiler> <include dir> <work dir> [method counts...]
+
+COMPILER="$1"
+INCLUDE_DIR="$2"
+WORK_DIR="$3"
+shift 3
+COUNTS="${*:-10 100 1000}"
+
+# Flags to compile with (may be overridden from the environment)
+FLAGS="${COMPILE_BENCH_FLAGS:--std=gnu++14 -O0 -g}"
+
+# Mock macros to generate: "arity" for SPOOKSHOW_MOCK_METHOD_N, or "variadic" for SPOOKSHOW_MOCK_METHOD
+FORM="${COMPILE_BENCH_FORM:-arity}"
+
+# Signatures cycled through by the generated mock methods
+SIGNATURES="void|()
+int|(int)
+@|(const @&)
+std::string|(const std::string&, int)
+void|(@, double)
+double|(double, double, double)
+bool|(const std::vector<@>&)
+void|(std::vector<int>)
+int*|(int*, std::size_t)
+@|(@, @, int, bool)"
+SIGNATURE_COUNT=10
+
+mkdir -p "$WORK_DIR"
+
+# Writes a translation unit declaring $1 mock methods to stdout
+generate()
+{
+  echo "#include <cstddef>"
+  echo "#include <string>"
+  echo "#include <vector>"
+  echo "#include <spookshow/spookshow.hpp>"
+  echo
+  index=0
+  while [ $index -lt $1 ]; do
+    class=$((index / 10))
+    if [ $((index % 10)) -eq 0 ]; then
+      echo "struct value_$class { int value; };"
+      echo
+      echo "class object_$class"
+      echo "{"
+      echo "public:"
+      echo "  virtual ~object_$class() = default;"
+      method=$index
+      while [ $method -lt $((index + 10)) ] && [ $method -lt $1 ]; do
+        line=$(echo "$SIGNATURES" | sed -n "$((method % SIGNATURE_COUNT + 1))p" | sed "s/@/value_$class/g")
+        ret=$(echo "$line" | cut -d'|' -f1)
+        params=$(echo "$line" | cut -d'|' -f2)
+        echo "  virtual $ret method_$method$params = 0;"
+        method=$((method + 1))
+      done
+      echo "};"
+      echo
+      echo "class mock_$class : public object_$class"
+      echo "{"
+      echo "public:"
+    fi
+    line=$(echo "$SIGNATURES" | sed -n "$((index % SIGNATURE_COUNT + 1))p" | sed "s/@/value_$class/g")
+    ret=$(echo "$line" | cut -d'|' -f1)
+    params=$(echo "$line" | cut -d'|' -f2)
+    if [ "$FORM" = "variadic" ]; then
+      echo "  SPOOKSHOW_MOCK_METHOD($ret, method_$index, $params);"
+    else
+      types=$(echo "$params" | sed 's/^(//; s/)$//')
+      if [ -z "$types" ]; then
+        echo "  SPOOKSHOW_MOCK_METHOD_0($ret, method_$index);"
+      else
+        arity=$(echo "$types" | awk -F',' '{ print NF }')
+        echo "  SPOOKSHOW_MOCK_METHOD_$arity($ret, method_$index, $types);"
+      fi
+    fi
+    index=$((index + 1))
+    if [ $((index % 10)) -eq 0 ] || [ $index -eq $1 ]; then
+      echo "};"
+      echo
+      echo "void use_mock_$class() { mock_$class mock; }"
+      echo
+    fi
+  done
+}
+
+printf "%-10s %12s %12s %14s %10s\n" "methods" "cpp (s)" "time (s)" "code+data (B)" "symbols"
+for count in $COUNTS; do
+  source="$WORK_DIR/mocks_$count.cpp"
+  object="$WORK_DIR/mocks_$count.o"
+  generate "$count" > "$source"
+
+  start=$(date +%s.%N)
+  $COMPILER $FLAGS -I"$INCLUDE_DIR" -E "$source" -o /dev/null
+  end=$(date +%s.%N)
+  cpp=$(echo "$start $end" | awk '{ printf "%.2f", $2 - $1 }')
+
+  start=$(date +%s.%N)
+  $COMPILER $FLAGS -I"$INCLUDE_DIR" -c "$source" -o "$object"
+  end=$(date +%s.%N)
+
+  time=$(echo "$start $end" | awk '{ printf "%.2f", $2 - $1 }')
+  text=$(size "$object" | awk 'NR == 2 { print $1 + $2 + $3 }')
+  symbols=$(nm --defined-only "$object" | wc -l)
+  printf "%-10s %12s %12s %14s %10s\n" "$count" "$cpp" "$time" "$text" "$symbols"
+done
@@ -0,0 +1,72 @@
+/**
+ * @file	concurrency_bench.cpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2026/10/16
+ */
+
+/* -- Includes -- */
+
+#include <climits>
+#include <memory>
+
+#include <benchmark/benchmark.h>
+#include <spookshow/spookshow.hpp>
+
+/* -- Namespaces -- */
+
+using namespace spookshow;
+
+/* -- Types -- */
+
+namespace
+{
+
+  class object
+  {
+  public:
+    virtual ~object() = default;
+    virtual int method(int value) { return 0; }
+  };
+
+  class mock : public object
+  {
+  public:
+    SPOOKSHOW_MOCK_METHOD_1(int, method, int);
+  };
+
+  /** Mock shared by all threads of the running benchmark. */
+  std::unique_ptr<mock> shared_mock;
+
+}
+
+/* -- Benchmarks -- */
+
+/**
+ * Calls a mock method in concurrent mode from several threads at once.
+ *
+ * With `always` set, every call reaches the published `always()` entry and takes the lock-free
+ * path. Otherwise the calls go to a `repeats()` entry, which serializes on the queue mutex.
+ */
+static void concurrency_shared_invoke(benchmark::State& state)
+{
+  const bool always = (state.range(0) != 0);
+  if (state.thread_index() == 0)
+  {
+    shared_mock.reset(new mock());
+    SPOOKSHOW(*shared_mock, method).enable_concurrency();
+    if (always)
+      SPOOKSHOW(*shared_mock, method).always(returns(1));
+    else
+      SPOOKSHOW(*shared_mock, method).repeats(INT_MAX, returns(1));
+  }
+
+  for (auto _ : state)
+    benchmark::DoNotOptimize(shared_mock->method(0));
+  state.SetItemsProcessed(state.iterations());
+
+  if (state.thread_index() == 0)
+    shared_mock.reset();
+}
+BENCHMARK(concurrency_shared_invoke)
+  ->Arg(0)->Arg(1)->ArgName("always")
+  ->ThreadRange(1, 32)->UseRealTime();
@@ -0,0 +1,95 @@
+/**
+ * @file	expectation_bench.cpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2026/10/16
+ */
+
+/* -- Includes -- */
+
+#include <memory>
+
+#include <benchmark/benchmark.h>
+#include <spookshow/spookshow.hpp>
+
+/* -- Namespaces -- */
+
+using namespace spookshow;
+
+/* -- Constants -- */
+
+namespace
+{
+  static const int BATCH_SIZE = 100;
+}
+
+/* -- Benchmarks -- */
+
+/**
+ * Fulfills an expectation which is not part of an order.
+ */
+static void expectation_fulfill(benchmark::State& state)
+{
+  expectation exp;
+  for (auto _ : state)
+    exp.fulfill();
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(expectation_fulfill);
+
+/**
+ * Fulfills an expectation in an order after its first fulfillment.
+ */
+static void expectation_fulfill_ordered_repeat(benchmark::State& state)
+{
+  expectation_order order;
+  expectation exp;
+  exp.fulfill();
+  for (auto _ : state)
+    exp.fulfill();
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(expectation_fulfill_ordered_repeat);
+
+/**
+ * Creates a batch of expectations, optionally in an order, and fulfills each of them once.
+ */
+static void expectation_create_fulfill(benchmark::State& state)
+{
+  const bool ordered = (state.range(0) != 0);
+  for (auto _ : state)
+  {
+    std::unique_ptr<expectation_order> order(ordered ? new expectation_order() : nullptr);
+    std::unique_ptr<expectation> exps[BATCH_SIZE];
+    for (int idx = 0; idx < BATCH_SIZE; idx++)
+      exps[idx].reset(new expectation());
+    for (int idx = 0; idx < BATCH_SIZE; idx++)
+      exps[idx]->fulfill();
+    for (int idx = BATCH_SIZE - 1; idx >= 0; idx--)
+      exps[idx].reset();
+  }
+  state.SetItemsProcessed(state.iterations() * BATCH_SIZE);
+}
+BENCHMARK(expectation_create_fulfill)->Arg(0)->Arg(1)->ArgName("ordered");
+
+/**
+ * Creates a batch of expectations which must all be fulfilled before a final one, and fulfills
+ * them in reverse order.
+ */
+static void expectation_create_fulfill_partial_order(benchmark::State& state)
+{
+  for (auto _ : state)
+  {
+    std::unique_ptr<expectation> exps[BATCH_SIZE];
+    expectation last;
+    for (int idx = 0; idx < BATCH_SIZE; idx++)
+    {
+      exps[idx].reset(new expectation());
+      last.after(*exps[idx]);
+    }
+    for (int idx = BATCH_SIZE - 1; idx >= 0; idx--)
+      exps[idx]->fulfill();
+    last.fulfill();
+  }
+  state.SetItemsProcessed(state.iterations() * BATCH_SIZE);
+}
+BENCHMARK(expectation_create_fulfill_partial_order);
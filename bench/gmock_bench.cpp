@@ -0,0 +1,185 @@
+/**
+ * @file	gmock_bench.cpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2026/10/16
+ *
+ * Google Mock equivalents of the Spookshow benchmarks, for comparison.
+ */
+
+/* -- Includes -- */
+
+#include <benchmark/benchmark.h>
+#include <gmock/gmock.h>
+
+/* -- Namespaces -- */
+
+using namespace testing;
+
+/* -- Types -- */
+
+namespace
+{
+
+  static const int BATCH_SIZE = 100;
+
+  class object
+  {
+  public:
+    virtual ~object() = default;
+    virtual int method(int value1, int value2) { return 0; }
+  };
+
+  class mock : public object
+  {
+  public:
+    MOCK_METHOD(int, method, (int, int), (override));
+  };
+
+  class wide_object
+  {
+  public:
+    virtual ~wide_object() = default;
+    virtual void method0() { }
+    virtual int method1(int value) { return 0; }
+    virtual int method2(int value1, int value2) { return 0; }
+    virtual int method3(int value1, int value2, int value3) { return 0; }
+    virtual void method4(int value1, int value2, int value3, int value4) { }
+  };
+
+  class wide_mock : public wide_object
+  {
+  public:
+    MOCK_METHOD(void, method0, (), (override));
+    MOCK_METHOD(int, method1, (int), (override));
+    MOCK_METHOD(int, method2, (int, int), (override));
+    MOCK_METHOD(int, method3, (int, int, int), (override));
+    MOCK_METHOD(void, method4, (int, int, int, int), (override));
+  };
+
+}
+
+/* -- Benchmarks -- */
+
+/**
+ * Equivalent of `invoke_once`, using a chain of `WillOnce()` actions.
+ */
+static void gmock_invoke_once(benchmark::State& state)
+{
+  for (auto _ : state)
+  {
+    mock mock;
+    auto& call = EXPECT_CALL(mock, method(testing::_, testing::_)).Times(BATCH_SIZE);
+    for (int idx = 0; idx < BATCH_SIZE; idx++)
+      call.WillOnce(Return(idx));
+    for (int idx = 0; idx < BATCH_SIZE; idx++)
+      benchmark::DoNotOptimize(mock.method(idx, idx));
+  }
+  state.SetItemsProcessed(state.iterations() * BATCH_SIZE);
+}
+BENCHMARK(gmock_invoke_once);
+
+/**
+ * Equivalent of `invoke_always`.
+ */
+static void gmock_invoke_always(benchmark::State& state)
+{
+  mock mock;
+  EXPECT_CALL(mock, method(testing::_, testing::_)).WillRepeatedly(Return(1));
+  for (auto _ : state)
+    benchmark::DoNotOptimize(mock.method(1, 2));
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(gmock_invoke_always);
+
+/**
+ * Equivalent of `condition_arg_eq`.
+ */
+static void gmock_condition_arg_eq(benchmark::State& state)
+{
+  mock mock;
+  EXPECT_CALL(mock, method(1, testing::_)).WillRepeatedly(Return(1));
+  for (auto _ : state)
+    benchmark::DoNotOptimize(mock.method(1, 2));
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(gmock_condition_arg_eq);
+
+/**
+ * Equivalent of `condition_arg_eq_each`.
+ */
+static void gmock_condition_arg_eq_each(benchmark::State& state)
+{
+  mock mock;
+  EXPECT_CALL(mock, method(1, 2)).WillRepeatedly(Return(1));
+  for (auto _ : state)
+    benchmark::DoNotOptimize(mock.method(1, 2));
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(gmock_condition_arg_eq_each);
+
+/**
+ * Equivalent of `condition_composed`.
+ */
+static void gmock_condition_composed(benchmark::State& state)
+{
+  mock mock;
+  EXPECT_CALL(mock, method(AllOf(Eq(1), Not(Eq(4))), AnyOf(Eq(2), Eq(3)))).WillRepeatedly(Return(1));
+  for (auto _ : state)
+    benchmark::DoNotOptimize(mock.method(1, 2));
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(gmock_condition_composed);
+
+/**
+ * Equivalent of `expectation_create_fulfill`, optionally in a sequence.
+ */
+static void gmock_expectation_create_fulfill(benchmark::State& state)
+{
+  const bool ordered = (state.range(0) != 0);
+  for (auto _ : state)
+  {
+    wide_mock mock;
+    Sequence sequence;
+    for (int idx = 0; idx < BATCH_SIZE; idx++)
+    {
+      if (ordered)
+        EXPECT_CALL(mock, method1(idx)).InSequence(sequence);
+      else
+        EXPECT_CALL(mock, method1(idx));
+    }
+    for (int idx = 0; idx < BATCH_SIZE; idx++)
+      mock.method1(idx);
+  }
+  state.SetItemsProcessed(state.iterations() * BATCH_SIZE);
+}
+BENCHMARK(gmock_expectation_create_fulfill)->Arg(0)->Arg(1)->ArgName("ordered");
+
+/**
+ * Equivalent of `mock_construct`.
+ */
+static void gmock_mock_construct(benchmark::State& state)
+{
+  for (auto _ : state)
+  {
+    wide_mock mock;
+    benchmark::DoNotOptimize(&mock);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(gmock_mock_construct);
+
+/**
+ * Equivalent of `mock_enqueue_reset`.
+ */
+static void gmock_mock_enqueue_reset(benchmark::State& state)
+{
+  wide_mock mock;
+  for (auto _ : state)
+  {
+    for (int idx = 0; idx < BATCH_SIZE; idx++)
+      EXPECT_CALL(mock, method2(testing::_, testing::_)).Times(AtMost(1)).WillOnce(Return(idx)).RetiresOnSaturation();
+    Mock::VerifyAndClearExpectations(&mock);
+  }
+  state.SetItemsProcessed(state.iterations() * BATCH_SIZE);
+}
+BENCHMARK(gmock_mock_enqueue_reset);
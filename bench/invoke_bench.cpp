@@ -0,0 +1,200 @@
+/**
+ * @file	invoke_bench.cpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2026/10/16
+ */
+
+/* -- Includes -- */
+
+#include <climits>
+
+#include <benchmark/benchmark.h>
+#include <spookshow/spookshow.hpp>
+
+/* -- Namespaces -- */
+
+using namespace spookshow;
+
+/* -- Types -- */
+
+namespace
+{
+
+  static const int BATCH_SIZE = 100;
+
+  class object
+  {
+  public:
+    virtual ~object() = default;
+    virtual int method(int value1, int value2) { return 0; }
+  };
+
+  class mock : public object
+  {
+  public:
+    SPOOKSHOW_MOCK_METHOD_2(int, method, int, int);
+  };
+
+}
+
+/* -- Benchmarks -- */
+
+/**
+ * Enqueues a batch of `once()` entries and then calls through all of them.
+ */
+static void invoke_once(benchmark::State& state)
+{
+  mock mock;
+  SPOOKSHOW(mock, method).reserve(BATCH_SIZE);
+  for (auto _ : state)
+  {
+    for (int idx = 0; idx < BATCH_SIZE; idx++)
+      SPOOKSHOW(mock, method).once(returns(idx));
+    for (int idx = 0; idx < BATCH_SIZE; idx++)
+      benchmark::DoNotOptimize(mock.method(idx, idx));
+  }
+  state.SetItemsProcessed(state.iterations() * BATCH_SIZE);
+}
+BENCHMARK(invoke_once);
+
+/**
+ * Calls a `repeats()` entry.
+ */
+static void invoke_repeats(benchmark::State& state)
+{
+  mock mock;
+  SPOOKSHOW(mock, method).repeats(INT_MAX, returns(1));
+  for (auto _ : state)
+    benchmark::DoNotOptimize(mock.method(1, 2));
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(invoke_repeats);
+
+/**
+ * Calls an `always()` entry.
+ */
+static void invoke_always(benchmark::State& state)
+{
+  mock mock;
+  SPOOKSHOW(mock, method).always(returns(1));
+  for (auto _ : state)
+    benchmark::DoNotOptimize(mock.method(1, 2));
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(invoke_always);
+
+/**
+ * Calls an `always()` entry which fulfills an expectation.
+ */
+static void invoke_always_fulfills(benchmark::State& state)
+{
+  mock mock;
+  expectation exp;
+  SPOOKSHOW(mock, method).always(returns(1)).fulfills(exp);
+  for (auto _ : state)
+    benchmark::DoNotOptimize(mock.method(1, 2));
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(invoke_always_fulfills);
+
+/**
+ * Calls a method with a functor registered for each of `range(0)` keys, cycling through the keys.
+ */
+static void invoke_keyed(benchmark::State& state)
+{
+  const int key_count = static_cast<int>(state.range(0));
+  mock mock;
+  for (int key = 0; key < key_count; key++)
+    SPOOKSHOW(mock, method).when<0>(key, returns(key));
+
+  int key = 0;
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(mock.method(key, 0));
+    key = (key + 7919) % key_count;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(invoke_keyed)->Arg(16)->Arg(100000);
+
+/**
+ * Calls a method in spy mode whose call log is full, so every call overwrites the oldest record.
+ */
+static void invoke_spy(benchmark::State& state)
+{
+  mock mock;
+  SPOOKSHOW(mock, method).spy(BATCH_SIZE);
+  for (auto _ : state)
+    benchmark::DoNotOptimize(mock.method(1, 2));
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(invoke_spy);
+
+/**
+ * Calls an `always()` entry returning values from a generator.
+ */
+static void invoke_stream(benchmark::State& state)
+{
+  mock mock;
+  int next = 0;
+  SPOOKSHOW(mock, method).always(returns_from([&next] { return next++; }));
+  for (auto _ : state)
+    benchmark::DoNotOptimize(mock.method(1, 2));
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(invoke_stream);
+
+/**
+ * Calls an `always()` entry guarded by a single `arg_eq` condition.
+ */
+static void condition_arg_eq(benchmark::State& state)
+{
+  mock mock;
+  SPOOKSHOW(mock, method).always(returns(1)).requires(arg_eq<0>(1));
+  for (auto _ : state)
+    benchmark::DoNotOptimize(mock.method(1, 2));
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(condition_arg_eq);
+
+/**
+ * Calls an `always()` entry guarded by a condition on each argument.
+ */
+static void condition_arg_eq_each(benchmark::State& state)
+{
+  mock mock;
+  SPOOKSHOW(mock, method).always(returns(1)).requires(arg_eq<0>(1)).requires(arg_eq<1>(2));
+  for (auto _ : state)
+    benchmark::DoNotOptimize(mock.method(1, 2));
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(condition_arg_eq_each);
+
+/**
+ * Calls an `always()` entry guarded by a composed condition.
+ */
+static void condition_composed(benchmark::State& state)
+{
+  mock mock;
+  SPOOKSHOW(mock, method).always(returns(1))
+    .requires(arg_eq<0>(1) && (arg_eq<1>(2) || arg_eq<1>(3)) && !arg_eq<0>(4));
+  for (auto _ : state)
+    benchmark::DoNotOptimize(mock.method(1, 2));
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(condition_composed);
+
+/**
+ * Calls an `always()` entry guarded by a plain lambda.
+ */
+static void condition_lambda(benchmark::State& state)
+{
+  mock mock;
+  SPOOKSHOW(mock, method).always(returns(1)).requires([] (int value1, int value2) {
+      return (value1 == 1 && value2 == 2);
+    });
+  for (auto _ : state)
+    benchmark::DoNotOptimize(mock.method(1, 2));
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(condition_lambda);
@@ -0,0 +1,13 @@
+/**
+ * @file	main.cpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2026/10/16
+ */
+
+/* -- Includes -- */
+
+#include <benchmark/benchmark.h>
+
+/* -- Procedures -- */
+
+BENCHMARK_MAIN();
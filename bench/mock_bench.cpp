@@ -0,0 +1,136 @@
+/**
+ * @file	mock_bench.cpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2026/10/16
+ */
+
+/* -- Includes -- */
+
+#include <memory>
+
+#include <benchmark/benchmark.h>
+#include <spookshow/spookshow.hpp>
+
+/* -- Namespaces -- */
+
+using namespace spookshow;
+
+/* -- Types -- */
+
+namespace
+{
+
+  static const int BATCH_SIZE = 100;
+
+  class object
+  {
+  public:
+    virtual ~object() = default;
+    virtual void method0() { }
+    virtual int method1(int value) { return 0; }
+    virtual int method2(int value1, int value2) { return 0; }
+    virtual int method3(int value1, int value2, int value3) { return 0; }
+    virtual void method4(int value1, int value2, int value3, int value4) { }
+  };
+
+  class mock : public object
+  {
+  public:
+    SPOOKSHOW_MOCK_METHOD_0(void, method0);
+    SPOOKSHOW_MOCK_METHOD_1(int, method1, int);
+    SPOOKSHOW_MOCK_METHOD_2(int, method2, int, int);
+    SPOOKSHOW_MOCK_METHOD_3(int, method3, int, int, int);
+    SPOOKSHOW_MOCK_METHOD_4(void, method4, int, int, int, int);
+  };
+
+}
+
+/* -- Benchmarks -- */
+
+/**
+ * Constructs and destroys a mock with five methods.
+ */
+static void mock_construct(benchmark::State& state)
+{
+  for (auto _ : state)
+  {
+    mock mock;
+    benchmark::DoNotOptimize(&mock);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(mock_construct);
+
+/**
+ * Enqueues a batch of `once()` entries and then resets the method.
+ */
+static void mock_enqueue_reset(benchmark::State& state)
+{
+  mock mock;
+  for (auto _ : state)
+  {
+    for (int idx = 0; idx < BATCH_SIZE; idx++)
+      SPOOKSHOW(mock, method2).once(returns(idx));
+    SPOOKSHOW(mock, method2).reset();
+  }
+  state.SetItemsProcessed(state.iterations() * BATCH_SIZE);
+}
+BENCHMARK(mock_enqueue_reset);
+
+/**
+ * Enqueues an `always()` entry with a condition and an expectation, and then resets the method.
+ */
+static void mock_enqueue_configured_reset(benchmark::State& state)
+{
+  mock mock;
+  expectation exp;
+  exp.fulfill();
+  for (auto _ : state)
+  {
+    SPOOKSHOW(mock, method2).always(returns(1)).requires(arg_eq<0>(1)).fulfills(exp);
+    SPOOKSHOW(mock, method2).reset();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(mock_enqueue_configured_reset);
+
+/**
+ * Scripts a batch of configured `once()` entries on a fresh mock, optionally under a
+ * `scripting_arena`, and then destroys the mock.
+ */
+static void mock_script_batch(benchmark::State& state)
+{
+  expectation exp;
+  exp.fulfill();
+  for (auto _ : state)
+  {
+    std::unique_ptr<scripting_arena> arena(state.range(0) ? new scripting_arena() : nullptr);
+    mock mock;
+    for (int idx = 0; idx < BATCH_SIZE; idx++)
+      SPOOKSHOW(mock, method2).once(returns(idx)).requires(arg_eq<0>(idx)).fulfills(exp);
+  }
+  state.SetItemsProcessed(state.iterations() * BATCH_SIZE);
+}
+BENCHMARK(mock_script_batch)->Arg(0)->Arg(1)->ArgName("arena");
+
+/**
+ * Declares many mocks, scripts a few of them under a `mock_registry`, and then verifies and
+ * resets the registry.
+ */
+static void mock_registry_verify_reset(benchmark::State& state)
+{
+  static const int MOCK_COUNT = 1000;
+  static const int SCRIPTED_COUNT = 10;
+
+  mock_registry registry;
+  std::unique_ptr<mock[]> mocks(new mock[MOCK_COUNT]);
+  for (auto _ : state)
+  {
+    for (int idx = 0; idx < SCRIPTED_COUNT; idx++)
+      SPOOKSHOW(mocks[idx * (MOCK_COUNT / SCRIPTED_COUNT)], method2).always(returns(idx));
+    benchmark::DoNotOptimize(registry.verify_all());
+    registry.reset_all();
+  }
+  state.SetItemsProcessed(state.iterations() * SCRIPTED_COUNT);
+}
+BENCHMARK(mock_registry_verify_reset);
@@ -0,0 +1,148 @@
+/**
+ * @file	queue_bench.cpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2026/10/16
+ */
+
+/* -- Includes -- */
+
+#include <queue>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <spookshow/spookshow.hpp>
+
+/* -- Namespaces -- */
+
+using namespace spookshow;
+
+/* -- Types -- */
+
+namespace
+{
+
+  static const int ENTRY_COUNT = 1000000;
+
+  /**
+   * Stand-in with the same layout as a `method<void(int)>` functor queue entry.
+   */
+  class entry
+  {
+  public:
+
+    explicit entry(int count)
+      : m_functor([] (int) { }),
+        m_count(count)
+    { }
+
+    internal::inline_function<void(int), DEFAULT_INLINE_CAPACITY> m_functor;
+    int m_count;
+    internal::compact_vector<internal::inline_function<bool(int), DEFAULT_INLINE_CAPACITY>> m_conditions;
+    internal::compact_vector<expectation*> m_expectations;
+
+  };
+
+  class object
+  {
+  public:
+    virtual ~object() = default;
+    virtual void method(int value) { }
+    virtual int next() { return 0; }
+  };
+
+  class mock : public object
+  {
+  public:
+    SPOOKSHOW_MOCK_METHOD_1(void, method, int);
+    SPOOKSHOW_MOCK_METHOD_0(int, next);
+  };
+
+}
+
+/* -- Benchmarks -- */
+
+/**
+ * Enqueues and drains entries using the `std::queue` the functor queue was previously built on.
+ */
+static void queue_deque_enqueue_drain(benchmark::State& state)
+{
+  for (auto _ : state)
+  {
+    std::queue<entry> queue;
+    for (int idx = 0; idx < ENTRY_COUNT; idx++)
+      queue.push(entry(1));
+    while (!queue.empty())
+    {
+      queue.front().m_functor(0);
+      queue.pop();
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * ENTRY_COUNT);
+}
+BENCHMARK(queue_deque_enqueue_drain)->Unit(benchmark::kMillisecond);
+
+/**
+ * Enqueues and drains entries using the contiguous `ring_buffer`.
+ */
+static void queue_ring_buffer_enqueue_drain(benchmark::State& state)
+{
+  for (auto _ : state)
+  {
+    internal::ring_buffer<entry> queue;
+    for (int idx = 0; idx < ENTRY_COUNT; idx++)
+      queue.emplace_back(1);
+    while (!queue.empty())
+    {
+      queue.front().m_functor(0);
+      queue.pop_front();
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * ENTRY_COUNT);
+}
+BENCHMARK(queue_ring_buffer_enqueue_drain)->Unit(benchmark::kMillisecond);
+
+/**
+ * Enqueues and drains `once()` entries on a mock method, optionally reserving space first.
+ */
+static void queue_method_enqueue_drain(benchmark::State& state)
+{
+  const bool reserve = (state.range(0) != 0);
+  for (auto _ : state)
+  {
+    mock mock;
+    if (reserve)
+      SPOOKSHOW(mock, method).reserve(ENTRY_COUNT);
+    for (int idx = 0; idx < ENTRY_COUNT; idx++)
+      SPOOKSHOW(mock, method).once(noops());
+    for (int idx = 0; idx < ENTRY_COUNT; idx++)
+      mock.method(idx);
+  }
+  state.SetItemsProcessed(state.iterations() * ENTRY_COUNT);
+}
+BENCHMARK(queue_method_enqueue_drain)->Arg(0)->Arg(1)->ArgName("reserve")->Unit(benchmark::kMillisecond);
+
+/**
+ * Scripts and drains a sequence of return values, either as one `once()` entry per value or as a
+ * single `returns_each()` entry.
+ */
+static void queue_method_return_sequence(benchmark::State& state)
+{
+  const bool each = (state.range(0) != 0);
+  std::vector<int> values;
+  for (int idx = 0; idx < ENTRY_COUNT; idx++)
+    values.push_back(idx);
+
+  for (auto _ : state)
+  {
+    mock mock;
+    if (each)
+      SPOOKSHOW(mock, next).once(returns_each(values));
+    else
+      for (int value : values)
+        SPOOKSHOW(mock, next).once(returns(value));
+    for (int idx = 0; idx < ENTRY_COUNT; idx++)
+      benchmark::DoNotOptimize(mock.next());
+  }
+  state.SetItemsProcessed(state.iterations() * ENTRY_COUNT);
+}
+BENCHMARK(queue_method_return_sequence)->Arg(0)->Arg(1)->ArgName("each")->Unit(benchmark::kMillisecond);
@@ -0,0 +1,139 @@
+/**
+ * @file	arena.hpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2026/10/17
+ */
+
+#pragma once
+
+/* -- Includes -- */
+
+#include <atomic>
+#include <cstddef>
+
+/* -- Types -- */
+
+namespace spookshow
+{
+
+  namespace internal
+  {
+
+    /**
+     * Allocates storage for scripting a mock method, from the current arena if there is one.
+     *
+     * The storage is aligned as for `::operator new()`.
+     */
+    void* allocate_scripting(std::size_t size);
+
+    /**
+     * Releases storage returned by `allocate_scripting()`. Storage carved from an arena is only
+     * released along with the arena.
+     */
+    void deallocate_scripting(void* storage) noexcept;
+
+  }
+
+  /**
+   * Scope in which memory for scripting mock methods is carved from a monotonic arena.
+   *
+   * While an arena exists, the storage allocated by `once()`, `repeats()`, `always()`, `requires()`
+   * and `fulfills()` on the same thread (condition and expectation lists, and functors too large to
+   * be stored inline) is taken from large chunks owned by the arena. Freeing that storage does
+   * nothing, and the chunks are all released at once when the arena is destroyed. Setup-heavy tests
+   * then spend almost no time in `malloc()` and `free()`.
+   *
+   * Arenas are scoped like expectation orders: each thread has its own stack of arenas, and only
+   * the innermost one is used. An arena must outlive every mock method scripted while it exists,
+   * so it should be declared before them (e.g., as the first member of a test fixture). Destroying
+   * an arena while storage carved from it is still in use is reported as an error. Storage carved
+   * from an arena may be released on any thread.
+   */
+  class scripting_arena final
+  {
+  public:
+
+    /** The default size of the chunks carved up by an arena. */
+    static const std::size_t DEFAULT_CHUNK_SIZE = 64 * 1024;
+
+    /**
+     * Creates a new arena, which is used for scripting on this thread until it is destroyed.
+     *
+     * @param chunk_size
+     * The size of the first chunk. Each subsequent chunk is twice as large as the last, up to 16
+     * times this size.
+     */
+    explicit scripting_arena(std::size_t chunk_size = DEFAULT_CHUNK_SIZE);
+    ~scripting_arena();
+
+  private:
+
+    scripting_arena(const scripting_arena&) = delete;
+    scripting_arena& operator =(const scripting_arena&) = delete;
+
+  public:
+
+    /**
+     * Returns the number of bytes which have been carved from this arena.
+     */
+    std::size_t allocated() const
+    {
+      return m_allocated;
+    }
+
+    /**
+     * Returns the number of chunks this arena has allocated.
+     */
+    std::size_t chunks() const
+    {
+      return m_chunk_count;
+    }
+
+  private:
+
+    friend void* spookshow::internal::allocate_scripting(std::size_t size);
+    friend void spookshow::internal::deallocate_scripting(void* storage) noexcept;
+
+    class chunk;
+
+    void* allocate(std::size_t size);
+    chunk* add_chunk(std::size_t size);
+    bool release(const void* storage);
+
+    scripting_arena* const m_previous;
+    const std::size_t m_minimum_chunk_size;
+    std::size_t m_chunk_size;
+    chunk* m_chunks;
+    unsigned char* m_next;
+    unsigned char* m_end;
+    std::size_t m_allocated;
+    std::size_t m_chunk_count;
+    std::atomic<std::size_t> m_live;
+
+  };
+
+  namespace internal
+  {
+
+    /**
+     * Allocation policy for containers used when scripting mock methods.
+     */
+    class scripting_allocation final
+    {
+    public:
+
+      static void* allocate(std::size_t size)
+      {
+        return spookshow::internal::allocate_scripting(size);
+      }
+
+      static void deallocate(void* storage) noexcept
+      {
+        spookshow::internal::deallocate_scripting(storage);
+      }
+
+    };
+
+  }
+
+}
@@ -0,0 +1,275 @@
+/**
+ * @file	call_log.hpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2026/10/16
+ */
+
+#pragma once
+
+/* -- Includes -- */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <spookshow/spookshow.hpp>
+#include <spookshow/ring_buffer.hpp>
+
+/* -- Types -- */
+
+namespace spookshow
+{
+
+  /**
+   * Enumeration of the ways in which a full call log can record a new call.
+   */
+  enum class log_policy
+  {
+    /** The oldest record is discarded to make room for the new one. */
+    overwrite_oldest,
+
+    /** The new call is not recorded. */
+    keep_oldest,
+  };
+
+  /**
+   * Record of a single call to a mock method in spy mode.
+   */
+  template <typename... TArgs>
+  class call_record final
+  {
+  public:
+
+    /** Sequence number of the call. This increases across all mock methods, so records from different methods can be ordered. */
+    std::uint64_t sequence;
+
+    /** Time of the call, in nanoseconds of a monotonic clock. */
+    std::uint64_t timestamp;
+
+    /** Copies of the arguments of the call. */
+    std::tuple<TArgs...> arguments;
+
+  };
+
+  namespace internal
+  {
+
+    /**
+     * Returns the sequence number for a new call record.
+     */
+    std::uint64_t next_call_sequence();
+
+    /**
+     * Returns the current time of a monotonic clock, in nanoseconds.
+     */
+    std::uint64_t call_timestamp();
+
+    /**
+     * Signature-independent part of `call_log`.
+     */
+    class call_log_base
+    {
+    public:
+
+      virtual ~call_log_base();
+
+      /** Returns the maximum number of records in the log. */
+      std::size_t capacity() const
+      {
+        return m_capacity;
+      }
+
+      /**
+       * Returns the total number of calls made, including any which were not recorded. Unlike the
+       * records themselves, this may be read while calls are being made.
+       */
+      std::uint64_t calls() const
+      {
+        return m_calls.load(std::memory_order_relaxed);
+      }
+
+      /**
+       * Records a call.
+       *
+       * @param arguments
+       * Pointer to a tuple of `const` references to the arguments of the call.
+       */
+      virtual void record(const void* arguments) = 0;
+
+    protected:
+
+      /**
+       * Serializes calls recorded from several threads.
+       */
+      class record_guard final
+      {
+      public:
+
+        explicit record_guard(std::atomic<bool>& locked)
+          : m_locked(locked)
+        {
+          if (m_locked.exchange(true, std::memory_order_acquire))
+            lock_contended();
+        }
+
+        ~record_guard()
+        {
+          m_locked.store(false, std::memory_order_release);
+        }
+
+      private:
+
+        record_guard(const record_guard&) = delete;
+        record_guard& operator =(const record_guard&) = delete;
+
+        /** Waits for another thread to finish recording, and then takes the lock. */
+        void lock_contended();
+
+        std::atomic<bool>& m_locked;
+
+      };
+
+      call_log_base(std::size_t capacity, log_policy policy, std::size_t sample_interval);
+
+      /**
+       * Counts a call, and returns `true` if it should be recorded in a log currently holding
+       * `size` records. If the oldest record must be discarded first, `overwrite` is set.
+       */
+      bool admit(std::size_t size, bool& overwrite)
+      {
+        // the count is only changed while the lock is held, so it does not need an atomic increment
+        const std::uint64_t call = m_calls.load(std::memory_order_relaxed);
+        m_calls.store(call + 1, std::memory_order_relaxed);
+        if (call % m_sample_interval != 0)
+          return false;
+        overwrite = (size == m_capacity);
+        return (!overwrite || m_policy == log_policy::overwrite_oldest);
+      }
+
+      std::atomic<bool> m_locked { false };
+
+    private:
+
+      call_log_base(const call_log_base&) = delete;
+      call_log_base& operator =(const call_log_base&) = delete;
+
+      const std::size_t m_capacity;
+      const log_policy m_policy;
+      const std::size_t m_sample_interval;
+      std::atomic<std::uint64_t> m_calls { 0 };
+
+    };
+
+  }
+
+  /**
+   * Bounded log of the calls made to a mock method in spy mode.
+   *
+   * Storage for every record is allocated when the log is created, so recording a call never
+   * allocates (beyond whatever copying the arguments requires). Every `sample_interval`th call is
+   * recorded, and once the log is full, `log_policy` decides whether the oldest record is
+   * overwritten. Calls may be recorded from several threads, but the log must not be queried
+   * while calls are being made.
+   */
+  template <typename... TArgs>
+  class call_log final : public spookshow::internal::call_log_base
+  {
+  public:
+
+    /** Type of the records in this log. */
+    using record_type = spookshow::call_record<std::decay_t<TArgs>...>;
+
+    call_log(std::size_t capacity, log_policy policy, std::size_t sample_interval)
+      : call_log_base(capacity, policy, sample_interval)
+    {
+      m_records.reserve(capacity);
+    }
+
+    /** Returns the number of records in the log. */
+    std::size_t size() const
+    {
+      return m_records.size();
+    }
+
+    /** Returns `true` if no calls have been recorded. */
+    bool empty() const
+    {
+      return m_records.empty();
+    }
+
+    /** Returns the record at the specified position, counting from the oldest record. */
+    const record_type& operator [](std::size_t position) const
+    {
+      return m_records[position];
+    }
+
+    /** Returns the oldest record in the log. */
+    const record_type& front() const
+    {
+      return m_records[0];
+    }
+
+    /** Returns the newest record in the log. */
+    const record_type& back() const
+    {
+      return m_records[m_records.size() - 1];
+    }
+
+    /**
+     * Returns the number of records whose arguments satisfy a condition.
+     *
+     * Any condition which could be passed to `requires()` may be used.
+     */
+    template <typename TCondition>
+    std::size_t count(const TCondition& condition) const
+    {
+      std::size_t matches = 0;
+      for (std::size_t position = 0; position < m_records.size(); position++)
+        if (satisfies(condition, m_records[position].arguments, std::index_sequence_for<TArgs...>()))
+          ++matches;
+      return matches;
+    }
+
+    /**
+     * Removes all records from the log. The call count is not reset.
+     */
+    void clear()
+    {
+      m_records.clear();
+    }
+
+    virtual void record(const void* arguments) override
+    {
+      using argument_tuple = std::tuple<const std::remove_reference_t<TArgs>&...>;
+
+      record_guard guard(m_locked);
+      bool overwrite = false;
+      if (!admit(m_records.size(), overwrite))
+        return;
+      if (overwrite)
+        m_records.pop_front();
+      m_records.emplace_back(record_type {
+          spookshow::internal::next_call_sequence(),
+          spookshow::internal::call_timestamp(),
+          *static_cast<const argument_tuple*>(arguments)
+        });
+    }
+
+  private:
+
+    template <typename TCondition, std::size_t... Indices>
+    static bool satisfies(const TCondition& condition,
+                          const std::tuple<std::decay_t<TArgs>...>& arguments,
+                          std::index_sequence<Indices...>)
+    {
+      return condition(std::get<Indices>(arguments)...);
+    }
+
+    spookshow::internal::ring_buffer<record_type> m_records;
+
+  };
+
+}
@@ -0,0 +1,205 @@
+/**
+ * @file	compact_vector.hpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2026/10/16
+ */
+
+#pragma once
+
+/* -- Includes -- */
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include <spookshow/spookshow.hpp>
+
+/* -- Types -- */
+
+namespace spookshow
+{
+
+  namespace internal
+  {
+
+    /**
+     * Allocation policy using the global `::operator new()`.
+     */
+    class heap_allocation final
+    {
+    public:
+
+      static void* allocate(std::size_t size)
+      {
+        return ::operator new(size);
+      }
+
+      static void deallocate(void* storage) noexcept
+      {
+        ::operator delete(storage);
+      }
+
+    };
+
+    /**
+     * Minimal move-only vector.
+     *
+     * Unlike `std::vector`, this class is guaranteed to be trivially relocatable (it is just a
+     * pointer and two counts), so objects containing it may be moved around with `memcpy()`. It is
+     * also half the size, and does not allocate until the first element is added. Storage is
+     * obtained from `TAllocation`, which provides static `allocate()` and `deallocate()` functions.
+     */
+    template <typename T, typename TAllocation = heap_allocation>
+    class compact_vector final
+    {
+    private:
+
+      static const std::uint32_t MINIMUM_CAPACITY = 2;
+      static const std::uint32_t MAXIMUM_CAPACITY = std::numeric_limits<std::uint32_t>::max();
+
+    public:
+
+      compact_vector() noexcept
+        : m_data(nullptr),
+          m_size(0),
+          m_capacity(0)
+      { }
+
+      compact_vector(compact_vector&& other) noexcept
+        : m_data(other.m_data),
+          m_size(other.m_size),
+          m_capacity(other.m_capacity)
+      {
+        other.m_data = nullptr;
+        other.m_size = 0;
+        other.m_capacity = 0;
+      }
+
+      compact_vector& operator =(compact_vector&& other) noexcept
+      {
+        if (this != &other)
+        {
+          release();
+          std::swap(m_data, other.m_data);
+          std::swap(m_size, other.m_size);
+          std::swap(m_capacity, other.m_capacity);
+        }
+        return *this;
+      }
+
+      ~compact_vector()
+      {
+        release();
+      }
+
+    private:
+
+      compact_vector(const compact_vector&) = delete;
+      compact_vector& operator =(const compact_vector&) = delete;
+
+    public:
+
+      /** Returns `true` if the vector is empty. */
+      bool empty() const { return (m_size == 0); }
+
+      /** Returns the number of elements in the vector. */
+      std::size_t size() const { return m_size; }
+
+      /** Returns an iterator to the first element. */
+      T* begin() { return m_data; }
+      const T* begin() const { return m_data; }
+
+      /** Returns an iterator past the last element. */
+      T* end() { return m_data + m_size; }
+      const T* end() const { return m_data + m_size; }
+
+      /** Returns the element at the specified index. */
+      T& operator [](std::size_t index) { return m_data[index]; }
+      const T& operator [](std::size_t index) const { return m_data[index]; }
+
+      /**
+       * Constructs a new element at the end of the vector.
+       */
+      template <typename... TArgs>
+      T& emplace_back(TArgs&&... args)
+      {
+        if (m_size == m_capacity)
+          grow();
+        T* element = new (m_data + m_size) T(std::forward<TArgs>(args)...);
+        ++m_size;
+        return *element;
+      }
+
+      /**
+       * Ensures that the vector can hold at least `count` elements without growing.
+       */
+      void reserve(std::size_t count)
+      {
+        if (count <= m_capacity)
+          return;
+        if (count > MAXIMUM_CAPACITY)
+          spookshow::internal::handle_error("Exceeded the maximum size of a compact_vector!");
+        reallocate(static_cast<std::uint32_t>(count));
+      }
+
+      /**
+       * Removes all elements from the vector, releasing its storage.
+       */
+      void clear()
+      {
+        release();
+      }
+
+    private:
+
+      void grow()
+      {
+        if (m_capacity == 0)
+          reallocate(MINIMUM_CAPACITY);
+        else if (m_capacity <= MAXIMUM_CAPACITY / 2)
+          reallocate(m_capacity * 2);
+        else if (m_capacity < MAXIMUM_CAPACITY)
+          reallocate(MAXIMUM_CAPACITY);
+        else
+          spookshow::internal::handle_error("Exceeded the maximum size of a compact_vector!");
+      }
+
+      void reallocate(std::uint32_t new_capacity)
+      {
+        static_assert(std::is_nothrow_move_constructible<T>::value,
+                      "compact_vector elements must be nothrow move constructible!");
+
+        T* new_data = static_cast<T*>(TAllocation::allocate(new_capacity * sizeof(T)));
+        for (std::uint32_t idx = 0; idx < m_size; idx++)
+        {
+          new (new_data + idx) T(std::move(m_data[idx]));
+          m_data[idx].~T();
+        }
+
+        TAllocation::deallocate(m_data);
+        m_data = new_data;
+        m_capacity = new_capacity;
+      }
+
+      void release()
+      {
+        for (std::uint32_t idx = 0; idx < m_size; idx++)
+          m_data[idx].~T();
+        TAllocation::deallocate(m_data);
+        m_data = nullptr;
+        m_size = 0;
+        m_capacity = 0;
+      }
+
+      T* m_data;
+      std::uint32_t m_size;
+      std::uint32_t m_capacity;
+
+    };
+
+  }
+
+}
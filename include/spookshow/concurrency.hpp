@@ -0,0 +1,205 @@
+/**
+ * @file	concurrency.hpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2026/10/16
+ */
+
+#pragma once
+
+/* -- Includes -- */
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+/* -- Types -- */
+
+namespace spookshow
+{
+
+  namespace internal
+  {
+
+    /**
+     * Synchronization state for a mock method which is called from several threads.
+     *
+     * Changes to the functor queue are serialized by a mutex (see `queue_lock`). While the front of
+     * the queue is an `always()` entry, a copy of that entry is *published*, and callers invoke the
+     * copy without taking the mutex at all. Callers register in one of several reader counters (each on its
+     * own cache line) while they use the published copy, and a copy which has been withdrawn is
+     * only destroyed once each counter has been observed at zero since it was withdrawn. Callers
+     * leaving a counter at zero try to destroy withdrawn copies too, so they are reclaimed while
+     * the method is being called continuously, not only when the queue changes.
+     */
+    class concurrent_state final
+    {
+    public:
+
+      /** Function used to destroy a published object. */
+      using deleter = void (*)(const void* object);
+
+      /**
+       * Registers the calling thread as a reader of the published object for its lifetime.
+       */
+      class reader final
+      {
+      public:
+
+        explicit reader(concurrent_state& state)
+          : m_state(state),
+            m_counter(state.m_stripes[stripe_index()].counter)
+        {
+          m_counter.fetch_add(1, std::memory_order_seq_cst);
+          m_published = state.m_published.load(std::memory_order_seq_cst);
+        }
+
+        ~reader()
+        {
+          if (m_counter.fetch_sub(1, std::memory_order_release) == 1 &&
+              m_state.m_retired.load(std::memory_order_relaxed))
+            m_state.reclaim_after_read();
+        }
+
+        /** Returns the published object, or `nullptr` if nothing is published. */
+        const void* published() const
+        {
+          return m_published;
+        }
+
+      private:
+
+        reader(const reader&) = delete;
+        reader& operator =(const reader&) = delete;
+
+        concurrent_state& m_state;
+        std::atomic<int>& m_counter;
+        const void* m_published;
+
+      };
+
+      concurrent_state();
+      ~concurrent_state();
+
+    private:
+
+      concurrent_state(const concurrent_state&) = delete;
+      concurrent_state& operator =(const concurrent_state&) = delete;
+
+    public:
+
+      /**
+       * Locks the mutex serializing all changes to the functor queue. The mutex is recursive.
+       */
+      void lock();
+
+      /**
+       * Unlocks the mutex serializing all changes to the functor queue.
+       */
+      void unlock();
+
+      /**
+       * Returns `true` if an object is currently published. The mutex must be held.
+       */
+      bool published() const
+      {
+        return (m_published.load(std::memory_order_relaxed) != nullptr);
+      }
+
+      /**
+       * Replaces the published object with `object`, which may be `nullptr`. The previous object is
+       * destroyed once no reader can still be using it. The mutex must be held.
+       */
+      void publish(const void* object, deleter deleter);
+
+    private:
+
+      static const std::size_t STRIPE_COUNT = 32;
+      static const std::size_t CACHE_LINE_SIZE = 64;
+
+      /**
+       * Reader counter padded out to a full cache line.
+       */
+      class stripe final
+      {
+      public:
+        char padding[CACHE_LINE_SIZE - sizeof(std::atomic<int>)];
+        std::atomic<int> counter { 0 };
+      };
+
+      /**
+       * Returns the reader counter assigned to the calling thread.
+       */
+      static std::size_t stripe_index()
+      {
+        static std::atomic<std::size_t> next_index { 0 };
+        static thread_local std::size_t index = next_index.fetch_add(1, std::memory_order_relaxed) % STRIPE_COUNT;
+        return index;
+      }
+
+      class serialized_state;
+
+      void reclaim();
+      void reclaim_after_read();
+
+      std::atomic<const void*> m_published;
+      std::atomic<bool> m_retired;
+      deleter m_deleter;
+      stripe m_stripes[STRIPE_COUNT];
+      const std::unique_ptr<serialized_state> m_serialized;
+
+    };
+
+    /**
+     * Movable lock on the functor queue of a mock method.
+     *
+     * A default-constructed lock does not lock anything, which is used for methods which are not
+     * in concurrent mode.
+     */
+    class queue_lock final
+    {
+    public:
+
+      queue_lock()
+        : m_state(nullptr)
+      { }
+
+      explicit queue_lock(concurrent_state& state)
+        : m_state(&state)
+      {
+        m_state->lock();
+      }
+
+      queue_lock(queue_lock&& other)
+        : m_state(other.m_state)
+      {
+        other.m_state = nullptr;
+      }
+
+      ~queue_lock()
+      {
+        unlock();
+      }
+
+      /**
+       * Releases the lock early.
+       */
+      void unlock()
+      {
+        if (m_state)
+          m_state->unlock();
+        m_state = nullptr;
+      }
+
+    private:
+
+      queue_lock(const queue_lock&) = delete;
+      queue_lock& operator =(const queue_lock&) = delete;
+      queue_lock& operator =(queue_lock&&) = delete;
+
+      concurrent_state* m_state;
+
+    };
+
+  }
+
+}
@@ -8,6 +8,11 @@
 
 /* -- Includes -- */
 
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
 #include <spookshow/spookshow.hpp>
 
 /* -- Types -- */
@@ -18,6 +23,42 @@ namespace spookshow
   namespace internal
   {
 
+    /**
+     * Selects an argument from a parameter pack at compile time, without copying it.
+     */
+    template <std::size_t Index>
+    class nth_argument final
+    {
+    public:
+      template <typename TFirst, typename... TRest>
+      static decltype(auto) get(const TFirst&, const TRest&... rest)
+      {
+        return nth_argument<Index - 1>::get(rest...);
+      }
+    };
+
+    template <>
+    class nth_argument<0> final
+    {
+    public:
+      template <typename TFirst, typename... TRest>
+      static const TFirst& get(const TFirst& first, const TRest&...)
+      {
+        return first;
+      }
+    };
+
+    /**
+     * Returns a reference to the argument at position `Index`.
+     */
+    template <int Index, typename... TArgs>
+    inline decltype(auto) get_argument(const TArgs&... args)
+    {
+      static_assert(Index >= 0 && static_cast<std::size_t>(Index) < sizeof...(TArgs),
+                    "Condition argument index is out of range for this method!");
+      return nth_argument<Index>::get(args...);
+    }
+
     /**
      * Functor class encapsulating a condition on a method call.
      */
@@ -29,8 +70,8 @@ namespace spookshow
       /**
        * Creates a new `condition_functor` wrapping the specified condition lambda.
        */
-      explicit condition_functor(const TLambda& lambda)
-        : m_lambda(lambda)
+      explicit condition_functor(TLambda lambda)
+        : m_lambda(std::move(lambda))
       { }
 
       /**
@@ -47,6 +88,231 @@ namespace spookshow
       TLambda m_lambda;
     };
 
+    /**
+     * Condition which succeeds if all of its operands succeed.
+     *
+     * Chained `&&` operators are flattened into a single `condition_all`, which evaluates its
+     * operands in order and stops at the first one which fails.
+     */
+    template <typename... TConditions>
+    class condition_all final
+    {
+    public:
+
+      explicit condition_all(std::tuple<TConditions...>&& conditions)
+        : m_conditions(std::move(conditions))
+      { }
+
+      template <typename... TArgs>
+      bool operator ()(const TArgs&... args) const
+      {
+        return evaluate<0>(std::integral_constant<bool, (sizeof...(TConditions) == 0)>(), args...);
+      }
+
+      /** Releases the operands of this condition, for flattening into another condition. */
+      std::tuple<TConditions...>&& operands() &&
+      {
+        return std::move(m_conditions);
+      }
+
+      /** Returns the operands of this condition, for flattening into another condition. */
+      const std::tuple<TConditions...>& operands() const &
+      {
+        return m_conditions;
+      }
+
+    private:
+
+      template <std::size_t Index, typename... TArgs>
+      bool evaluate(std::false_type, const TArgs&... args) const
+      {
+        return (std::get<Index>(m_conditions)(args...) &&
+                evaluate<Index + 1>(std::integral_constant<bool, (Index + 1 == sizeof...(TConditions))>(), args...));
+      }
+
+      template <std::size_t Index, typename... TArgs>
+      bool evaluate(std::true_type, const TArgs&...) const
+      {
+        return true;
+      }
+
+      std::tuple<TConditions...> m_conditions;
+
+    };
+
+    /**
+     * Condition which succeeds if any of its operands succeed.
+     *
+     * Chained `||` operators are flattened into a single `condition_any`, which evaluates its
+     * operands in order and stops at the first one which succeeds.
+     */
+    template <typename... TConditions>
+    class condition_any final
+    {
+    public:
+
+      explicit condition_any(std::tuple<TConditions...>&& conditions)
+        : m_conditions(std::move(conditions))
+      { }
+
+      template <typename... TArgs>
+      bool operator ()(const TArgs&... args) const
+      {
+        return evaluate<0>(std::integral_constant<bool, (sizeof...(TConditions) == 0)>(), args...);
+      }
+
+      /** Releases the operands of this condition, for flattening into another condition. */
+      std::tuple<TConditions...>&& operands() &&
+      {
+        return std::move(m_conditions);
+      }
+
+      /** Returns the operands of this condition, for flattening into another condition. */
+      const std::tuple<TConditions...>& operands() const &
+      {
+        return m_conditions;
+      }
+
+    private:
+
+      template <std::size_t Index, typename... TArgs>
+      bool evaluate(std::false_type, const TArgs&... args) const
+      {
+        return (std::get<Index>(m_conditions)(args...) ||
+                evaluate<Index + 1>(std::integral_constant<bool, (Index + 1 == sizeof...(TConditions))>(), args...));
+      }
+
+      template <std::size_t Index, typename... TArgs>
+      bool evaluate(std::true_type, const TArgs&...) const
+      {
+        return false;
+      }
+
+      std::tuple<TConditions...> m_conditions;
+
+    };
+
+    /**
+     * Condition which succeeds if its operand fails.
+     */
+    template <typename TCondition>
+    class condition_not final
+    {
+    public:
+
+      explicit condition_not(TCondition condition)
+        : m_condition(std::move(condition))
+      { }
+
+      template <typename... TArgs>
+      bool operator ()(const TArgs&... args) const
+      {
+        return !m_condition(args...);
+      }
+
+      /** Releases the operand of this condition. */
+      TCondition&& operand() &&
+      {
+        return std::move(m_condition);
+      }
+
+      /** Returns the operand of this condition. */
+      const TCondition& operand() const &
+      {
+        return m_condition;
+      }
+
+    private:
+      TCondition m_condition;
+    };
+
+    /**
+     * Trait identifying the condition types which may be combined with `&&`, `||` and `!`.
+     */
+    template <typename T>
+    class is_condition : public std::false_type { };
+
+    template <typename TLambda>
+    class is_condition<condition_functor<TLambda>> : public std::true_type { };
+
+    template <typename... TConditions>
+    class is_condition<condition_all<TConditions...>> : public std::true_type { };
+
+    template <typename... TConditions>
+    class is_condition<condition_any<TConditions...>> : public std::true_type { };
+
+    template <typename TCondition>
+    class is_condition<condition_not<TCondition>> : public std::true_type { };
+
+    template <typename TFirst, typename TSecond>
+    using enable_if_conditions_t =
+      std::enable_if_t<is_condition<std::decay_t<TFirst>>::value && is_condition<std::decay_t<TSecond>>::value>;
+
+    /**
+     * Trait identifying instantiations of a composite condition template.
+     */
+    template <template <typename...> class TComposite, typename T>
+    class is_composite : public std::false_type { };
+
+    template <template <typename...> class TComposite, typename... TConditions>
+    class is_composite<TComposite, TComposite<TConditions...>> : public std::true_type { };
+
+    template <template <typename...> class TComposite, typename TCondition>
+    inline auto flatten(TCondition&& condition, std::true_type)
+    {
+      return std::forward<TCondition>(condition).operands();
+    }
+
+    template <template <typename...> class TComposite, typename TCondition>
+    inline auto flatten(TCondition&& condition, std::false_type)
+    {
+      return std::tuple<std::decay_t<TCondition>>(std::forward<TCondition>(condition));
+    }
+
+    /**
+     * Returns the operands a condition contributes to a flattened `TComposite` condition.
+     *
+     * A condition which is already a `TComposite` contributes all of its operands (moved, if the
+     * condition is an rvalue). Any other condition contributes itself.
+     */
+    template <template <typename...> class TComposite, typename TCondition>
+    inline auto flatten(TCondition&& condition)
+    {
+      return flatten<TComposite>(std::forward<TCondition>(condition),
+                                 is_composite<TComposite, std::decay_t<TCondition>>());
+    }
+
+    template <typename TCondition>
+    inline auto negate(TCondition&& condition, std::true_type)
+    {
+      return std::forward<TCondition>(condition).operand();
+    }
+
+    template <typename TCondition>
+    inline auto negate(TCondition&& condition, std::false_type)
+    {
+      return condition_not<std::decay_t<TCondition>>(std::forward<TCondition>(condition));
+    }
+
+    /**
+     * Returns the negation of a condition. Double negations cancel out.
+     */
+    template <typename TCondition>
+    inline auto negate(TCondition&& condition)
+    {
+      return negate(std::forward<TCondition>(condition),
+                    is_composite<condition_not, std::decay_t<TCondition>>());
+    }
+
+    /**
+     * Creates a `condition_all` or `condition_any` from a tuple of operands.
+     */
+    template <template <typename...> class TComposite, typename... TConditions>
+    inline TComposite<TConditions...> make_composite(std::tuple<TConditions...>&& conditions)
+    {
+      return TComposite<TConditions...>(std::move(conditions));
+    }
+
   }
 
 }
@@ -60,62 +326,58 @@ namespace spookshow
    * Creates a condition requiring that an argument be equal to a specific value.
    */
   template <int Index, typename TValue>
-  inline auto arg_eq(const TValue& value)
+  inline auto arg_eq(TValue&& value)
   {
-    auto lambda = [value] (auto... args) -> bool {
-      return (std::get<Index>(std::tuple<decltype(args)...>(args...)) == value);
+    auto lambda = [value = std::forward<TValue>(value)] (const auto&... args) -> bool {
+      return (spookshow::internal::get_argument<Index>(args...) == value);
     };
-    return spookshow::internal::condition_functor<decltype(lambda)>(lambda);
+    return spookshow::internal::condition_functor<decltype(lambda)>(std::move(lambda));
   }
 
   /**
    * Creates a condition requiring that an argument be not equal to a specific value.
    */
   template <int Index, typename TValue>
-  inline auto arg_ne(const TValue& value)
+  inline auto arg_ne(TValue&& value)
   {
-    auto lambda = [value] (auto... args) -> bool {
-      return (std::get<Index>(std::tuple<decltype(args)...>(args...)) != value);
+    auto lambda = [value = std::forward<TValue>(value)] (const auto&... args) -> bool {
+      return (spookshow::internal::get_argument<Index>(args...) != value);
     };
-    return spookshow::internal::condition_functor<decltype(lambda)>(lambda);
+    return spookshow::internal::condition_functor<decltype(lambda)>(std::move(lambda));
   }
 
   /**
    * Creates a condition from a logical AND of two other conditions.
    */
-  template <typename TFirstLambda, typename TSecondLambda>
-  inline auto operator &&(const spookshow::internal::condition_functor<TFirstLambda>& first,
-                          const spookshow::internal::condition_functor<TSecondLambda>& second)
+  template <typename TFirst, typename TSecond,
+            typename = spookshow::internal::enable_if_conditions_t<TFirst, TSecond>>
+  inline auto operator &&(TFirst&& first, TSecond&& second)
   {
-    auto lambda = [first, second] (auto... args) -> bool {
-      return (first(args...) && second(args...));
-    };
-    return spookshow::internal::condition_functor<decltype(lambda)>(lambda);
+    return spookshow::internal::make_composite<spookshow::internal::condition_all>(
+      std::tuple_cat(spookshow::internal::flatten<spookshow::internal::condition_all>(std::forward<TFirst>(first)),
+                     spookshow::internal::flatten<spookshow::internal::condition_all>(std::forward<TSecond>(second))));
   }
 
   /**
    * Creates a condition from a logical OR of two other conditions.
    */
-  template <typename TFirstLambda, typename TSecondLambda>
-  inline auto operator ||(const spookshow::internal::condition_functor<TFirstLambda>& first,
-                          const spookshow::internal::condition_functor<TSecondLambda>& second)
+  template <typename TFirst, typename TSecond,
+            typename = spookshow::internal::enable_if_conditions_t<TFirst, TSecond>>
+  inline auto operator ||(TFirst&& first, TSecond&& second)
   {
-    auto lambda = [first, second] (auto... args) -> bool {
-      return (first(args...) || second(args...));
-    };
-    return spookshow::internal::condition_functor<decltype(lambda)>(lambda);
+    return spookshow::internal::make_composite<spookshow::internal::condition_any>(
+      std::tuple_cat(spookshow::internal::flatten<spookshow::internal::condition_any>(std::forward<TFirst>(first)),
+                     spookshow::internal::flatten<spookshow::internal::condition_any>(std::forward<TSecond>(second))));
   }
 
   /**
    * Creates a condition from a logical NOT of another condition.
    */
-  template <typename TLambda>
-  inline auto operator !(const spookshow::internal::condition_functor<TLambda>& cond)
+  template <typename TCondition,
+            typename = spookshow::internal::enable_if_conditions_t<TCondition, TCondition>>
+  inline auto operator !(TCondition&& condition)
   {
-    auto lambda = [cond] (auto... args) -> bool {
-      return !cond(args...);
-    };
-    return spookshow::internal::condition_functor<decltype(lambda)>(lambda);
+    return spookshow::internal::negate(std::forward<TCondition>(condition));
   }
 
 }
@@ -8,6 +8,9 @@
 
 /* -- Includes -- */
 
+#include <atomic>
+#include <cstdint>
+#include <memory>
 #include <string>
 #include <spookshow/spookshow.hpp>
 
@@ -27,6 +30,9 @@ namespace spookshow
 
     static const int MINIMUM_REQUIRED_COUNT = 1;
 
+    // set in the count until the first fulfillment has checked the order and constraints
+    static const std::uint64_t FIRST_PENDING = std::uint64_t(1) << 63;
+
   public:
 
     /**
@@ -67,6 +73,37 @@ namespace spookshow
      */
     expectation(const std::string& name, int required_count);
 
+    /**
+     * Creates a new expectation in an explicit order, with no name and a required count of one.
+     *
+     * @param order
+     * The order which this expectation joins. This overrides the current scoped order, if any.
+     */
+    explicit expectation(expectation_order& order)
+      : expectation(order, std::string(), MINIMUM_REQUIRED_COUNT)
+    { }
+
+    /**
+     * Creates a new expectation in an explicit order, with a required count of one.
+     */
+    expectation(expectation_order& order, const std::string& name)
+      : expectation(order, name, MINIMUM_REQUIRED_COUNT)
+    { }
+
+    /**
+     * Creates a new expectation in an explicit order.
+     *
+     * @param order
+     * The order which this expectation joins. This overrides the current scoped order, if any.
+     *
+     * @param name
+     * The name of the expectation.
+     *
+     * @param required_count
+     * The number of times the requirement must be fulfilled.
+     */
+    expectation(expectation_order& order, const std::string& name, int required_count);
+
     ~expectation();
 
   private:
@@ -84,25 +121,70 @@ namespace spookshow
       return m_name.empty() ? "No Name" : m_name;
     }
 
+    /**
+     * Returns the number of times this expectation has been fulfilled.
+     */
+    std::uint64_t count() const
+    {
+      return (m_count.load(std::memory_order_relaxed) & ~FIRST_PENDING);
+    }
+
     /**
      * Returns `true` if this expectation has been fulfilled.
      */
     bool is_fulfilled() const
     {
-      return (m_count >= m_required_count);
+      return (m_required_count <= 0 || count() >= static_cast<std::uint64_t>(m_required_count));
     }
 
+    /**
+     * Requires this expectation to be fulfilled after another one.
+     *
+     * The first fulfillment of this expectation fails if `predecessor` has not been fulfilled yet.
+     * This expresses partial orders which an `expectation_order` cannot: for example, after
+     * `c.after(a).after(b)`, `a` and `b` may be fulfilled in either order, but both before `c`.
+     * Each expectation only counts its unfulfilled predecessors, so checking the constraints is
+     * constant-time however many of them there are.
+     *
+     * Constraints must be added before either expectation is shared between threads.
+     *
+     * @return
+     * This expectation, so that constraints can be chained.
+     */
+    expectation& after(expectation& predecessor);
+
     /**
      * Fulfills this expectation once.
+     *
+     * This may be called from any thread. Only the first fulfillment checks the expectation order
+     * and any `after()` constraints, so subsequent fulfillments are a single atomic increment.
+     * Fulfillments racing with the first one wait for it to finish, so no thread returns from
+     * here before the order has moved past this expectation.
      */
-    void fulfill();
+    void fulfill()
+    {
+      const std::uint64_t previous = m_count.fetch_add(1, std::memory_order_acquire);
+      if (previous & FIRST_PENDING)
+        fulfill_pending(previous);
+    }
 
   private:
 
+    /**
+     * Constraints added with `after()`. These are only allocated if they are used.
+     */
+    class links;
+
     const std::string m_name;
     const int m_required_count;
     expectation_order* const m_order;
-    int m_count;
+    const std::uint64_t m_sequence;
+    std::atomic<std::uint64_t> m_count;
+    std::unique_ptr<links> m_links;
+
+    expectation(expectation_order* order, const std::string& name, int required_count);
+    void fulfill_pending(std::uint64_t previous);
+    bool fulfill_first();
 
   };
 
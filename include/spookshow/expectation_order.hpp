@@ -8,8 +8,8 @@
 
 /* -- Includes -- */
 
-#include <queue>
-#include <stack>
+#include <atomic>
+#include <cstdint>
 
 #include <spookshow/spookshow.hpp>
 
@@ -23,14 +23,36 @@ namespace spookshow
   /**
    * Class imposing an order on expectation fulfillment.
    *
-   * This class has no public API. It works with `spookshow::expectation` to enforce an expected
-   * order in which expectations must be fulfilled.
+   * This class works with `spookshow::expectation` to enforce an expected order in which
+   * expectations must be fulfilled. Each expectation in the order is given a sequence number, and
+   * the order only tracks the number of the next expectation to be fulfilled, so expectations may
+   * be fulfilled from different threads without any locking.
+   *
+   * A scoped order (the default) is automatically joined by every expectation created on the same
+   * thread while it exists. Each thread has its own stack of scoped orders. An explicit order is
+   * only joined by expectations which are passed it on construction, so it can be shared between
+   * threads to assert that an expectation on one thread is fulfilled before one on another.
+   *
+   * An order is a total order. Partial orders are expressed with `expectation::after()`, which
+   * may be combined with an order.
    */
   class expectation_order
   {
   public:
 
-    expectation_order();
+    /**
+     * How expectations join an order.
+     */
+    enum class registration
+    {
+      /** Expectations created on this thread while the order exists join it automatically. */
+      scoped,
+
+      /** Expectations only join the order when it is passed to their constructor. */
+      explicit_only,
+    };
+
+    explicit expectation_order(registration registration = registration::scoped);
     ~expectation_order();
 
   private:
@@ -40,13 +62,13 @@ namespace spookshow
 
     friend class expectation;
 
-    static std::stack<expectation_order*> s_orders;
-    std::queue<const expectation*> m_expectations;
+    const registration m_registration;
+    std::atomic<std::uint64_t> m_size;
+    std::atomic<std::uint64_t> m_next;
 
     static expectation_order* current_order();
-    void enqueue_expectation(const expectation* exp);
-    void dequeue_expectation();
-    bool is_expectation_next(const expectation* exp) const;
+    std::uint64_t enqueue_expectation();
+    bool fulfill_expectation(std::uint64_t sequence);
 
   };
 
@@ -0,0 +1,145 @@
+/**
+ * @file	failure.hpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2026/10/16
+ */
+
+#pragma once
+
+/* -- Includes -- */
+
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <string>
+
+#include <spookshow/spookshow.hpp>
+
+/* -- Types -- */
+
+namespace spookshow
+{
+
+  class expectation;
+
+  namespace internal
+  {
+    class method_descriptor;
+  }
+
+  /**
+   * Enumeration of the kinds of test failure.
+   */
+  enum class failure_kind
+  {
+    /** A mock method was called while its functor queue was empty. */
+    unexpected_call,
+
+    /** A mock method was called with arguments which did not satisfy its conditions. */
+    unexpected_arguments,
+
+    /** A mock method was called after the return stream at the front of its queue had ended. */
+    exhausted_stream,
+
+    /** A registry was verified while a mock method still had `once()` or `repeats()` functors. */
+    unused_functors,
+
+    /** An expectation was destroyed before it had been fulfilled enough times. */
+    unfulfilled_expectation,
+
+    /** An expectation was fulfilled before the expectations preceding it in its order. */
+    out_of_order_expectation,
+  };
+
+  /**
+   * Structured record of a test failure.
+   *
+   * Records are cheap to create, because nothing is formatted until `message()` is called. They
+   * refer to objects owned by the caller (including the arguments of the failed call), so a record
+   * is only valid for the duration of the call to the failure handler.
+   */
+  class failure final
+  {
+  public:
+
+    /** The kind of failure. */
+    failure_kind kind;
+
+    /** The mock method which failed, or `nullptr` for expectation failures. */
+    const spookshow::internal::method_descriptor* method;
+
+    /** The expectation which failed, or `nullptr` for mock method failures. */
+    const spookshow::expectation* exp;
+
+    /**
+     * The number of times the expectation was fulfilled (for expectation failures), or the number
+     * of unused functors (for `failure_kind::unused_functors`).
+     */
+    std::uint64_t count;
+
+    /** The number of times the expectation was required to be fulfilled (for expectation failures). */
+    std::uint64_t required_count;
+
+    /** Opaque pointer to the arguments of the failed call, or `nullptr` if there are none. */
+    const void* arguments;
+
+    /** Function writing `arguments` to a stream, or `nullptr` if there are no arguments. */
+    void (*argument_formatter)(std::ostream& stream, const void* arguments);
+
+    /** For a summary reported by `failure_aggregation`, the number of identical failures suppressed. */
+    std::uint64_t suppressed;
+
+    /**
+     * Writes the arguments of the failed call to a stream, separated by commas.
+     *
+     * Arguments which cannot be written to a stream are shown as `?`.
+     */
+    void format_arguments(std::ostream& stream) const;
+
+    /**
+     * Formats a human-readable description of this failure.
+     */
+    std::string message() const;
+
+  };
+
+  /**
+   * Scope coalescing repeated mock method failures.
+   *
+   * While an instance of this class exists, only the first few failures of each kind for each
+   * mock method are passed to the failure handler. Further identical failures just increment a
+   * counter, and a single summary failure (with `failure::suppressed` set) is reported for each of
+   * them when the scope ends. Expectation failures are always reported immediately.
+   *
+   * Only failures on the thread which created the scope are aggregated; failures on other threads
+   * are reported immediately. Scopes may be nested, in which case the innermost one is used, and
+   * must be destroyed in the reverse order of their creation.
+   */
+  class failure_aggregation final
+  {
+  public:
+
+    /** The default number of identical failures reported before further ones are suppressed. */
+    static const std::uint64_t DEFAULT_REPORT_COUNT = 3;
+
+    explicit failure_aggregation(std::uint64_t report_count = DEFAULT_REPORT_COUNT);
+    ~failure_aggregation();
+
+  private:
+
+    failure_aggregation(const failure_aggregation&) = delete;
+    failure_aggregation& operator =(const failure_aggregation&) = delete;
+
+    friend void spookshow::internal::handle_failure(const failure& failure);
+
+    class entries;
+
+    failure_aggregation* const m_previous;
+    const std::uint64_t m_report_count;
+    const std::unique_ptr<entries> m_entries;
+
+    bool should_report(const failure& failure);
+
+  };
+
+}
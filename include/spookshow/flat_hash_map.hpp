@@ -0,0 +1,230 @@
+/**
+ * @file	flat_hash_map.hpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2026/10/16
+ */
+
+#pragma once
+
+/* -- Includes -- */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/* -- Types -- */
+
+namespace spookshow
+{
+
+  namespace internal
+  {
+
+    /**
+     * Open-addressing hash map with linear probing.
+     *
+     * Keys and values are stored in a single power-of-two sized block of slots, so a lookup is a
+     * hash and (usually) a single cache miss. Hashes are scrambled with Fibonacci hashing before
+     * being reduced to a slot index, so weak hashes (like `std::hash<int>`, which is the identity)
+     * do not cause clustering. Elements cannot be removed individually.
+     */
+    template <typename TKey, typename TValue, typename THash = std::hash<TKey>>
+    class flat_hash_map final
+    {
+    private:
+
+      static const std::size_t MINIMUM_CAPACITY = 16;
+
+      /**
+       * Storage for a single element.
+       */
+      class slot final
+      {
+      public:
+        bool occupied;
+        std::aligned_storage_t<sizeof(std::pair<TKey, TValue>), alignof(std::pair<TKey, TValue>)> storage;
+
+        std::pair<TKey, TValue>& element()
+        {
+          return *reinterpret_cast<std::pair<TKey, TValue>*>(&storage);
+        }
+      };
+
+    public:
+
+      flat_hash_map()
+        : m_slots(nullptr),
+          m_capacity(0),
+          m_shift(64),
+          m_size(0)
+      { }
+
+      ~flat_hash_map()
+      {
+        clear();
+        std::free(m_slots);
+      }
+
+    private:
+
+      flat_hash_map(const flat_hash_map&) = delete;
+      flat_hash_map& operator =(const flat_hash_map&) = delete;
+
+    public:
+
+      /** Returns `true` if the map is empty. */
+      bool empty() const
+      {
+        return (m_size == 0);
+      }
+
+      /** Returns the number of elements in the map. */
+      std::size_t size() const
+      {
+        return m_size;
+      }
+
+      /**
+       * Returns the value for `key`, or `nullptr` if there is none.
+       */
+      TValue* find(const TKey& key) const
+      {
+        if (m_size == 0)
+          return nullptr;
+
+        for (std::size_t index = home(key); ; index = (index + 1) & (m_capacity - 1))
+        {
+          slot& current = m_slots[index];
+          if (!current.occupied)
+            return nullptr;
+          if (current.element().first == key)
+            return &current.element().second;
+        }
+      }
+
+      /**
+       * Calls `function` with the key and value of each element, in no particular order.
+       */
+      template <typename TFunction>
+      void for_each(TFunction&& function) const
+      {
+        for (std::size_t index = 0; index < m_capacity; index++)
+        {
+          slot& current = m_slots[index];
+          if (current.occupied)
+            function(const_cast<const TKey&>(current.element().first), current.element().second);
+        }
+      }
+
+      /**
+       * Sets the value for `key`, replacing any existing value.
+       */
+      template <typename TKeyArg, typename TValueArg>
+      TValue& insert_or_assign(TKeyArg&& key, TValueArg&& value)
+      {
+        TValue* existing = find(key);
+        if (existing)
+        {
+          *existing = std::forward<TValueArg>(value);
+          return *existing;
+        }
+
+        // the load factor is kept at or below 3/4, so probe sequences stay short
+        if (4 * (m_size + 1) > 3 * m_capacity)
+          rehash(m_capacity == 0 ? MINIMUM_CAPACITY : 2 * m_capacity);
+
+        std::size_t index = home(key);
+        while (m_slots[index].occupied)
+          index = (index + 1) & (m_capacity - 1);
+
+        slot& target = m_slots[index];
+        new (&target.storage) std::pair<TKey, TValue>(std::forward<TKeyArg>(key), std::forward<TValueArg>(value));
+        target.occupied = true;
+        ++m_size;
+        return target.element().second;
+      }
+
+      /**
+       * Ensures that the map can hold at least `count` elements without rehashing.
+       */
+      void reserve(std::size_t count)
+      {
+        std::size_t new_capacity = (m_capacity == 0 ? MINIMUM_CAPACITY : m_capacity);
+        while (3 * new_capacity < 4 * count)
+          new_capacity *= 2;
+        if (new_capacity > m_capacity)
+          rehash(new_capacity);
+      }
+
+      /**
+       * Removes all elements from the map. The storage is retained for reuse.
+       */
+      void clear()
+      {
+        for (std::size_t index = 0; index < m_capacity && m_size != 0; index++)
+        {
+          slot& current = m_slots[index];
+          if (!current.occupied)
+            continue;
+          current.element().~pair();
+          current.occupied = false;
+          --m_size;
+        }
+      }
+
+    private:
+
+      std::size_t home(const TKey& key) const
+      {
+        const std::uint64_t hash = static_cast<std::uint64_t>(THash()(key));
+        return static_cast<std::size_t>((hash * UINT64_C(0x9E3779B97F4A7C15)) >> m_shift);
+      }
+
+      void rehash(std::size_t new_capacity)
+      {
+        slot* old_slots = m_slots;
+        const std::size_t old_capacity = m_capacity;
+
+        m_slots = static_cast<slot*>(std::malloc(new_capacity * sizeof(slot)));
+        if (!m_slots)
+          throw std::bad_alloc();
+        for (std::size_t index = 0; index < new_capacity; index++)
+          m_slots[index].occupied = false;
+
+        m_capacity = new_capacity;
+        m_shift = 64;
+        for (std::size_t capacity = new_capacity; capacity > 1; capacity >>= 1)
+          --m_shift;
+
+        for (std::size_t index = 0; index < old_capacity; index++)
+        {
+          slot& old_slot = old_slots[index];
+          if (!old_slot.occupied)
+            continue;
+
+          std::size_t new_index = home(old_slot.element().first);
+          while (m_slots[new_index].occupied)
+            new_index = (new_index + 1) & (m_capacity - 1);
+
+          new (&m_slots[new_index].storage) std::pair<TKey, TValue>(std::move(old_slot.element()));
+          m_slots[new_index].occupied = true;
+          old_slot.element().~pair();
+        }
+
+        std::free(old_slots);
+      }
+
+      slot* m_slots;
+      std::size_t m_capacity;
+      unsigned int m_shift;
+      std::size_t m_size;
+
+    };
+
+  }
+
+}
@@ -0,0 +1,435 @@
+/**
+ * @file	inline_function.hpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2026/10/16
+ */
+
+#pragma once
+
+/* -- Includes -- */
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include <spookshow/spookshow.hpp>
+#include <spookshow/arena.hpp>
+
+/* -- Constants -- */
+
+namespace spookshow
+{
+
+  /**
+   * The default number of bytes of inline storage for actions and conditions.
+   *
+   * This is large enough for a `std::function`, a `std::string`, or a lambda capturing up to four
+   * pointers. Larger callables are still accepted, but are stored on the heap.
+   */
+  static const std::size_t DEFAULT_INLINE_CAPACITY = 4 * sizeof(void*);
+
+}
+
+/* -- Types -- */
+
+namespace spookshow
+{
+
+  namespace internal
+  {
+
+    // required to use "function" syntax in class template
+    template <typename TSignature, std::size_t Capacity>
+    class inline_function;
+
+    /**
+     * Trait determining whether a callable may be called with the specified arguments through a
+     * `const` reference.
+     */
+    template <typename TCallable, typename TArgList, typename = void>
+    class is_const_callable : public std::false_type { };
+
+    template <typename... TArgs>
+    class argument_list final { };
+
+    template <typename TCallable, typename... TArgs>
+    class is_const_callable<TCallable,
+                            argument_list<TArgs...>,
+                            decltype(void(std::declval<const TCallable&>()(std::declval<TArgs>()...)))>
+      : public std::true_type { };
+
+    /**
+     * Signature-independent part of `inline_function`.
+     *
+     * This class manages the lifetime of the stored callable (copying, moving and destroying it),
+     * which is the same for every signature. It is shared between all `inline_function`
+     * instantiations with the same capacity, and may be stored by itself where the signature is
+     * known elsewhere (e.g., in the functor queue of a mock method).
+     */
+    template <std::size_t Capacity>
+    class inline_function_base
+    {
+    public:
+
+      /**
+       * Table of lifetime operations for a specific callable type.
+       */
+      class operations final
+      {
+      public:
+        std::size_t size;
+        void (*copy)(void* destination, const void* source);
+        void (*relocate)(void* destination, void* source);
+        void (*destroy)(void* storage);
+        bool const_callable;
+      };
+
+      static_assert(Capacity >= sizeof(void*), "Inline capacity must be able to hold a pointer!");
+
+      inline_function_base()
+        : m_operations(nullptr)
+      { }
+
+      inline_function_base(const inline_function_base& other)
+        : m_operations(other.m_operations)
+      {
+        if (m_operations)
+        {
+          if (!m_operations->copy)
+            spookshow::internal::handle_error("Attempted to copy a move-only callable!");
+          m_operations->copy(&m_storage, &other.m_storage);
+        }
+      }
+
+      inline_function_base(inline_function_base&& other) noexcept
+        : m_operations(other.m_operations)
+      {
+        if (m_operations)
+        {
+          relocate(&m_storage, &other.m_storage);
+          other.m_operations = nullptr;
+        }
+      }
+
+      ~inline_function_base()
+      {
+        clear();
+      }
+
+      inline_function_base& operator =(const inline_function_base& other)
+      {
+        if (this != &other)
+        {
+          inline_function_base copy(other);
+          *this = std::move(copy);
+        }
+        return *this;
+      }
+
+      inline_function_base& operator =(inline_function_base&& other) noexcept
+      {
+        if (this != &other)
+        {
+          clear();
+          if (other.m_operations)
+          {
+            m_operations = other.m_operations;
+            relocate(&m_storage, &other.m_storage);
+            other.m_operations = nullptr;
+          }
+        }
+        return *this;
+      }
+
+      /**
+       * Returns `true` if this object holds a callable.
+       */
+      explicit operator bool() const
+      {
+        return (m_operations != nullptr);
+      }
+
+      /**
+       * Returns `true` if this object may be copied (i.e., it is empty or its callable is not
+       * move-only).
+       */
+      bool copyable() const
+      {
+        return (m_operations == nullptr || m_operations->copy != nullptr);
+      }
+
+      /**
+       * Returns `true` if this object is empty or its callable may be called through a `const`
+       * reference (i.e., it is not a `mutable` lambda or a functor with a non-`const` call
+       * operator).
+       */
+      bool const_callable() const
+      {
+        return (m_operations == nullptr || m_operations->const_callable);
+      }
+
+    protected:
+
+      template <typename TSignature, std::size_t OtherCapacity>
+      friend class inline_function;
+
+      void relocate(void* destination, void* source)
+      {
+        if (m_operations->relocate)
+          m_operations->relocate(destination, source);
+        else
+          std::memcpy(destination, source, m_operations->size);
+      }
+
+      void clear()
+      {
+        if (m_operations)
+        {
+          if (m_operations->destroy)
+            m_operations->destroy(&m_storage);
+          m_operations = nullptr;
+        }
+      }
+
+      const operations* m_operations;
+      mutable std::aligned_storage_t<Capacity, alignof(void*)> m_storage;
+
+    };
+
+    /**
+     * Type-erased callable object which stores its target inline.
+     *
+     * This is a replacement for `std::function` which never allocates for callables of up to
+     * `Capacity` bytes. Callables which are larger (or which cannot be moved without throwing) are
+     * stored on the heap instead.
+     *
+     * This class adds no data to `inline_function_base`, so a callable may be stored as the base
+     * class and invoked later with `call()`.
+     */
+    template <typename TRet, typename... TArgs, std::size_t Capacity>
+    class inline_function<TRet(TArgs...), Capacity> final : public inline_function_base<Capacity>
+    {
+    private:
+
+      using base = inline_function_base<Capacity>;
+      using copy_function = void (*)(void* destination, const void* source);
+
+      /**
+       * Table of operations for a specific callable type. The lifetime operations come first, so
+       * that a pointer to this table is also a pointer to them.
+       */
+      class operations final
+      {
+      public:
+        typename base::operations lifetime;
+        TRet (*invoke)(void* storage, TArgs&&... args);
+      };
+
+      /**
+       * Returns the copy operation for a callable, or `nullptr` if it is move-only.
+       */
+      template <typename TOperations>
+      static constexpr copy_function copy_operation(std::true_type)
+      {
+        return &TOperations::copy;
+      }
+
+      template <typename TOperations>
+      static constexpr copy_function copy_operation(std::false_type)
+      {
+        return nullptr;
+      }
+
+      /**
+       * Operations for a callable stored in the inline buffer.
+       */
+      template <typename TCallable>
+      class inline_operations final
+      {
+      public:
+
+        static TRet invoke(void* storage, TArgs&&... args)
+        {
+          return (*static_cast<TCallable*>(storage))(std::forward<TArgs>(args)...);
+        }
+
+        static void copy(void* destination, const void* source)
+        {
+          new (destination) TCallable(*static_cast<const TCallable*>(source));
+        }
+
+        static void relocate(void* destination, void* source)
+        {
+          new (destination) TCallable(std::move(*static_cast<TCallable*>(source)));
+          static_cast<TCallable*>(source)->~TCallable();
+        }
+
+        static void destroy(void* storage)
+        {
+          static_cast<TCallable*>(storage)->~TCallable();
+        }
+
+        static const operations* table()
+        {
+          // trivial callables are relocated with memcpy() and need no destructor call
+          static constexpr operations table {
+            {
+              (std::is_empty<TCallable>::value ? 0 : sizeof(TCallable)),
+              copy_operation<inline_operations<TCallable>>(std::is_copy_constructible<TCallable>()),
+              (std::is_trivially_copyable<TCallable>::value ? nullptr : &relocate),
+              (std::is_trivially_destructible<TCallable>::value ? nullptr : &destroy),
+              is_const_callable<TCallable, argument_list<TArgs...>>::value
+            },
+            &invoke
+          };
+          return &table;
+        }
+
+      };
+
+      /**
+       * Operations for a callable which did not fit in the inline buffer.
+       *
+       * The callable is stored in scripting storage (see `scripting_arena`).
+       */
+      template <typename TCallable>
+      class heap_operations final
+      {
+      public:
+
+        static TRet invoke(void* storage, TArgs&&... args)
+        {
+          return (**static_cast<TCallable**>(storage))(std::forward<TArgs>(args)...);
+        }
+
+        static void copy(void* destination, const void* source)
+        {
+          new (destination) TCallable*(create(**static_cast<TCallable* const*>(source)));
+        }
+
+        static void destroy(void* storage)
+        {
+          TCallable* callable = *static_cast<TCallable**>(storage);
+          callable->~TCallable();
+          spookshow::internal::deallocate_scripting(callable);
+        }
+
+        template <typename TSource>
+        static TCallable* create(TSource&& source)
+        {
+          void* storage = spookshow::internal::allocate_scripting(sizeof(TCallable));
+          try
+          {
+            return new (storage) TCallable(std::forward<TSource>(source));
+          }
+          catch (...)
+          {
+            spookshow::internal::deallocate_scripting(storage);
+            throw;
+          }
+        }
+
+        static const operations* table()
+        {
+          // only the pointer is stored inline, so the callable can always be relocated with memcpy()
+          static constexpr operations table {
+            {
+              sizeof(TCallable*),
+              copy_operation<heap_operations<TCallable>>(std::is_copy_constructible<TCallable>()),
+              nullptr,
+              &destroy,
+              is_const_callable<TCallable, argument_list<TArgs...>>::value
+            },
+            &invoke
+          };
+          return &table;
+        }
+
+      };
+
+      template <typename TCallable>
+      using fits_inline = std::integral_constant<bool,
+                                                 sizeof(TCallable) <= Capacity &&
+                                                 alignof(TCallable) <= alignof(void*) &&
+                                                 std::is_nothrow_move_constructible<TCallable>::value>;
+
+      template <typename TCallable>
+      using is_compatible = std::integral_constant<bool,
+                                                   !std::is_base_of<base, std::decay_t<TCallable>>::value &&
+                                                   (std::is_void<TRet>::value ||
+                                                    std::is_convertible<std::result_of_t<std::decay_t<TCallable>&(TArgs...)>, TRet>::value)>;
+
+    public:
+
+      /**
+       * Creates an empty `inline_function`.
+       */
+      inline_function() = default;
+
+      /**
+       * Creates an empty `inline_function`.
+       */
+      inline_function(std::nullptr_t)
+        : inline_function()
+      { }
+
+      /**
+       * Creates an `inline_function` wrapping the specified callable object.
+       */
+      template <typename TCallable,
+                typename = std::enable_if_t<is_compatible<TCallable>::value>>
+      inline_function(TCallable&& callable)
+        : inline_function()
+      {
+        emplace<std::decay_t<TCallable>>(std::forward<TCallable>(callable), fits_inline<std::decay_t<TCallable>>());
+      }
+
+      /**
+       * Invokes the wrapped callable with the specified arguments.
+       *
+       * Parameters declared by value in the signature are taken by value, and then forwarded to
+       * the callable. Use `call()` to forward arguments without that extra move. Calling an empty
+       * `inline_function` is reported as an error.
+       */
+      TRet operator ()(TArgs... args) const
+      {
+        return call(*this, std::forward<TArgs>(args)...);
+      }
+
+      /**
+       * Invokes a callable of this signature which is stored as an `inline_function_base`.
+       *
+       * @note
+       * The callable must have been created as an `inline_function` with this signature.
+       */
+      static TRet call(const base& function, TArgs&&... args)
+      {
+        const operations* table = reinterpret_cast<const operations*>(function.m_operations);
+        if (!table)
+          spookshow::internal::handle_error("Attempted to call an empty inline_function!");
+        return table->invoke(&function.m_storage, std::forward<TArgs>(args)...);
+      }
+
+    private:
+
+      template <typename TCallable, typename TSource>
+      void emplace(TSource&& source, std::true_type)
+      {
+        new (&this->m_storage) TCallable(std::forward<TSource>(source));
+        this->m_operations = &inline_operations<TCallable>::table()->lifetime;
+      }
+
+      template <typename TCallable, typename TSource>
+      void emplace(TSource&& source, std::false_type)
+      {
+        new (&this->m_storage) TCallable*(heap_operations<TCallable>::create(std::forward<TSource>(source)));
+        this->m_operations = &heap_operations<TCallable>::table()->lifetime;
+      }
+
+    };
+
+  }
+
+}
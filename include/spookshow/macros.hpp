@@ -8,8 +8,17 @@
 
 /* -- Includes -- */
 
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
 #include <spookshow/spookshow.hpp>
 
+/* -- Types -- */
+
+// default inline capacity for mocks, may be shadowed in a mock class by SPOOKSHOW_INLINE_CAPACITY
+using spookshow_inline_capacity_ = std::integral_constant<std::size_t, spookshow::DEFAULT_INLINE_CAPACITY>;
+
 /* -- Implementation Macros -- */
 
 // these are for implementation, do not use these in user code
@@ -17,53 +26,238 @@
 #define SPOOKSHOW_METHOD_OBJECT_(meth)								\
   SPOOKSHOW_MOCK_METHOD_ ## meth ## _
 
+#define SPOOKSHOW_METHOD_DESCRIPTOR_(meth)							\
+  SPOOKSHOW_MOCK_DESCRIPTOR_ ## meth ## _
+
+// utilities
+
+#define SPOOKSHOW_CAT_(a, b)									\
+  SPOOKSHOW_CAT_IMPL_(a, b)
+#define SPOOKSHOW_CAT_IMPL_(a, b)								\
+  a ## b
+
+#define SPOOKSHOW_REMOVE_PARENS_(...)								\
+  __VA_ARGS__
+
+// second of two or more arguments
+#define SPOOKSHOW_SECOND_(...)									\
+  SPOOKSHOW_SECOND_IMPL_(__VA_ARGS__, )
+#define SPOOKSHOW_SECOND_IMPL_(a, b, ...)							\
+  b
+
+// expands to the first alternative if the argument is empty, and to the second otherwise (the
+// argument must not begin with a parenthesis)
+#define SPOOKSHOW_IF_EMPTY_(a, empty, nonempty)							\
+  SPOOKSHOW_SECOND_(SPOOKSHOW_EMPTY_PROBE_ a (empty), nonempty)
+#define SPOOKSHOW_EMPTY_PROBE_(...) ~, __VA_ARGS__
+
+// number of arguments (1 to 32), an empty argument list counts as one
+#define SPOOKSHOW_NARG_(...)									\
+  SPOOKSHOW_NARG_IMPL_(__VA_ARGS__, 32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, )
+#define SPOOKSHOW_NARG_IMPL_(a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22, a23, a24, a25, a26, a27, a28, a29, a30, a31, a32, n, ...)	\
+  n
+
+// declares the parameters of a mock method, for example (int, char) becomes int arg0, char arg1
+#define SPOOKSHOW_PARAMETERS_1_(a0) SPOOKSHOW_IF_EMPTY_(a0, , a0 arg0)
+#define SPOOKSHOW_PARAMETERS_2_(a0, a1) a0 arg0, a1 arg1
+#define SPOOKSHOW_PARAMETERS_3_(a0, a1, a2) a0 arg0, a1 arg1, a2 arg2
+#define SPOOKSHOW_PARAMETERS_4_(a0, a1, a2, a3) a0 arg0, a1 arg1, a2 arg2, a3 arg3
+#define SPOOKSHOW_PARAMETERS_5_(a0, a1, a2, a3, a4) a0 arg0, a1 arg1, a2 arg2, a3 arg3, a4 arg4
+#define SPOOKSHOW_PARAMETERS_6_(a0, a1, a2, a3, a4, a5) a0 arg0, a1 arg1, a2 arg2, a3 arg3, a4 arg4, a5 arg5
+#define SPOOKSHOW_PARAMETERS_7_(a0, a1, a2, a3, a4, a5, a6) a0 arg0, a1 arg1, a2 arg2, a3 arg3, a4 arg4, a5 arg5, a6 arg6
+#define SPOOKSHOW_PARAMETERS_8_(a0, a1, a2, a3, a4, a5, a6, a7) a0 arg0, a1 arg1, a2 arg2, a3 arg3, a4 arg4, a5 arg5, a6 arg6, a7 arg7
+#define SPOOKSHOW_PARAMETERS_9_(a0, a1, a2, a3, a4, a5, a6, a7, a8) a0 arg0, a1 arg1, a2 arg2, a3 arg3, a4 arg4, a5 arg5, a6 arg6, a7 arg7, a8 arg8
+#define SPOOKSHOW_PARAMETERS_10_(a0, a1, a2, a3, a4, a5, a6, a7, a8, a9) a0 arg0, a1 arg1, a2 arg2, a3 arg3, a4 arg4, a5 arg5, a6 arg6, a7 arg7, a8 arg8, a9 arg9
+#define SPOOKSHOW_PARAMETERS_11_(a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10) a0 arg0, a1 arg1, a2 arg2, a3 arg3, a4 arg4, a5 arg5, a6 arg6, a7 arg7, a8 arg8, a9 arg9, a10 arg10
+#define SPOOKSHOW_PARAMETERS_12_(a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11) a0 arg0, a1 arg1, a2 arg2, a3 arg3, a4 arg4, a5 arg5, a6 arg6, a7 arg7, a8 arg8, a9 arg9, a10 arg10, a11 arg11
+#define SPOOKSHOW_PARAMETERS_13_(a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12) a0 arg0, a1 arg1, a2 arg2, a3 arg3, a4 arg4, a5 arg5, a6 arg6, a7 arg7, a8 arg8, a9 arg9, a10 arg10, a11 arg11, a12 arg12
+#define SPOOKSHOW_PARAMETERS_14_(a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13) a0 arg0, a1 arg1, a2 arg2, a3 arg3, a4 arg4, a5 arg5, a6 arg6, a7 arg7, a8 arg8, a9 arg9, a10 arg10, a11 arg11, a12 arg12, a13 arg13
+#define SPOOKSHOW_PARAMETERS_15_(a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14) a0 arg0, a1 arg1, a2 arg2, a3 arg3, a4 arg4, a5 arg5, a6 arg6, a7 arg7, a8 arg8, a9 arg9, a10 arg10, a11 arg11, a12 arg12, a13 arg13, a14 arg14
+#define SPOOKSHOW_PARAMETERS_16_(a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15) a0 arg0, a1 arg1, a2 arg2, a3 arg3, a4 arg4, a5 arg5, a6 arg6, a7 arg7, a8 arg8, a9 arg9, a10 arg10, a11 arg11, a12 arg12, a13 arg13, a14 arg14, a15 arg15
+#define SPOOKSHOW_PARAMETERS_17_(a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16) a0 arg0, a1 arg1, a2 arg2, a3 arg3, a4 arg4, a5 arg5, a6 arg6, a7 arg7, a8 arg8, a9 arg9, a10 arg10, a11 arg11, a12 arg12, a13 arg13, a14 arg14, a15 arg15, a16 arg16
+#define SPOOKSHOW_PARAMETERS_18_(a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17) a0 arg0, a1 arg1, a2 arg2, a3 arg3, a4 arg4, a5 arg5, a6 arg6, a7 arg7, a8 arg8, a9 arg9, a10 arg10, a11 arg11, a12 arg12, a13 arg13, a14 arg14, a15 arg15, a16 arg16, a17 arg17
+#define SPOOKSHOW_PARAMETERS_19_(a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18) a0 arg0, a1 arg1, a2 arg2, a3 arg3, a4 arg4, a5 arg5, a6 arg6, a7 arg7, a8 arg8, a9 arg9, a10 arg10, a11 arg11, a12 arg12, a13 arg13, a14 arg14, a15 arg15, a16 arg16, a17 arg17, a18 arg18
+#define SPOOKSHOW_PARAMETERS_20_(a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19) a0 arg0, a1 arg1, a2 arg2, a3 arg3, a4 arg4, a5 arg5, a6 arg6, a7 arg7, a8 arg8, a9 arg9, a10 arg10, a11 arg11, a12 arg12, a13 arg13, a14 arg14, a15 arg15, a16 arg16, a17 arg17, a18 arg18, a19 arg19
+#define SPOOKSHOW_PARAMETERS_21_(a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20) a0 arg0, a1 arg1, a2 arg2, a3 arg3, a4 arg4, a5 arg5, a6 arg6, a7 arg7, a8 arg8, a9 arg9, a10 arg10, a11 arg11, a12 arg12, a13 arg13, a14 arg14, a15 arg15, a16 arg16, a17 arg17, a18 arg18, a19 arg19, a20 arg20
+#define SPOOKSHOW_PARAMETERS_22_(a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21) a0 arg0, a1 arg1, a2 arg2, a3 arg3, a4 arg4, a5 arg5, a6 arg6, a7 arg7, a8 arg8, a9 arg9, a10 arg10, a11 arg11, a12 arg12, a13 arg13, a14 arg14, a15 arg15, a16 arg16, a17 arg17, a18 arg18, a19 arg19, a20 arg20, a21 arg21
+#define SPOOKSHOW_PARAMETERS_23_(a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22) a0 arg0, a1 arg1, a2 arg2, a3 arg3, a4 arg4, a5 arg5, a6 arg6, a7 arg7, a8 arg8, a9 arg9, a10 arg10, a11 arg11, a12 arg12, a13 arg13, a14 arg14, a15 arg15, a16 arg16, a17 arg17, a18 arg18, a19 arg19, a20 arg20, a21 arg21, a22 arg22
+#define SPOOKSHOW_PARAMETERS_24_(a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22, a23) a0 arg0, a1 arg1, a2 arg2, a3 arg3, a4 arg4, a5 arg5, a6 arg6, a7 arg7, a8 arg8, a9 arg9, a10 arg10, a11 arg11, a12 arg12, a13 arg13, a14 arg14, a15 arg15, a16 arg16, a17 arg17, a18 arg18, a19 arg19, a20 arg20, a21 arg21, a22 arg22, a23 arg23
+#define SPOOKSHOW_PARAMETERS_25_(a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22, a23, a24) a0 arg0, a1 arg1, a2 arg2, a3 arg3, a4 arg4, a5 arg5, a6 arg6, a7 arg7, a8 arg8, a9 arg9, a10 arg10, a11 arg11, a12 arg12, a13 arg13, a14 arg14, a15 arg15, a16 arg16, a17 arg17, a18 arg18, a19 arg19, a20 arg20, a21 arg21, a22 arg22, a23 arg23, a24 arg24
+#define SPOOKSHOW_PARAMETERS_26_(a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22, a23, a24, a25) a0 arg0, a1 arg1, a2 arg2, a3 arg3, a4 arg4, a5 arg5, a6 arg6, a7 arg7, a8 arg8, a9 arg9, a10 arg10, a11 arg11, a12 arg12, a13 arg13, a14 arg14, a15 arg15, a16 arg16, a17 arg17, a18 arg18, a19 arg19, a20 arg20, a21 arg21, a22 arg22, a23 arg23, a24 arg24, a25 arg25
+#define SPOOKSHOW_PARAMETERS_27_(a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22, a23, a24, a25, a26) a0 arg0, a1 arg1, a2 arg2, a3 arg3, a4 arg4, a5 arg5, a6 arg6, a7 arg7, a8 arg8, a9 arg9, a10 arg10, a11 arg11, a12 arg12, a13 arg13, a14 arg14, a15 arg15, a16 arg16, a17 arg17, a18 arg18, a19 arg19, a20 arg20, a21 arg21, a22 arg22, a23 arg23, a24 arg24, a25 arg25, a26 arg26
+#define SPOOKSHOW_PARAMETERS_28_(a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22, a23, a24, a25, a26, a27) a0 arg0, a1 arg1, a2 arg2, a3 arg3, a4 arg4, a5 arg5, a6 arg6, a7 arg7, a8 arg8, a9 arg9, a10 arg10, a11 arg11, a12 arg12, a13 arg13, a14 arg14, a15 arg15, a16 arg16, a17 arg17, a18 arg18, a19 arg19, a20 arg20, a21 arg21, a22 arg22, a23 arg23, a24 arg24, a25 arg25, a26 arg26, a27 arg27
+#define SPOOKSHOW_PARAMETERS_29_(a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22, a23, a24, a25, a26, a27, a28) a0 arg0, a1 arg1, a2 arg2, a3 arg3, a4 arg4, a5 arg5, a6 arg6, a7 arg7, a8 arg8, a9 arg9, a10 arg10, a11 arg11, a12 arg12, a13 arg13, a14 arg14, a15 arg15, a16 arg16, a17 arg17, a18 arg18, a19 arg19, a20 arg20, a21 arg21, a22 arg22, a23 arg23, a24 arg24, a25 arg25, a26 arg26, a27 arg27, a28 arg28
+#define SPOOKSHOW_PARAMETERS_30_(a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22, a23, a24, a25, a26, a27, a28, a29) a0 arg0, a1 arg1, a2 arg2, a3 arg3, a4 arg4, a5 arg5, a6 arg6, a7 arg7, a8 arg8, a9 arg9, a10 arg10, a11 arg11, a12 arg12, a13 arg13, a14 arg14, a15 arg15, a16 arg16, a17 arg17, a18 arg18, a19 arg19, a20 arg20, a21 arg21, a22 arg22, a23 arg23, a24 arg24, a25 arg25, a26 arg26, a27 arg27, a28 arg28, a29 arg29
+#define SPOOKSHOW_PARAMETERS_31_(a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22, a23, a24, a25, a26, a27, a28, a29, a30) a0 arg0, a1 arg1, a2 arg2, a3 arg3, a4 arg4, a5 arg5, a6 arg6, a7 arg7, a8 arg8, a9 arg9, a10 arg10, a11 arg11, a12 arg12, a13 arg13, a14 arg14, a15 arg15, a16 arg16, a17 arg17, a18 arg18, a19 arg19, a20 arg20, a21 arg21, a22 arg22, a23 arg23, a24 arg24, a25 arg25, a26 arg26, a27 arg27, a28 arg28, a29 arg29, a30 arg30
+#define SPOOKSHOW_PARAMETERS_32_(a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22, a23, a24, a25, a26, a27, a28, a29, a30, a31) a0 arg0, a1 arg1, a2 arg2, a3 arg3, a4 arg4, a5 arg5, a6 arg6, a7 arg7, a8 arg8, a9 arg9, a10 arg10, a11 arg11, a12 arg12, a13 arg13, a14 arg14, a15 arg15, a16 arg16, a17 arg17, a18 arg18, a19 arg19, a20 arg20, a21 arg21, a22 arg22, a23 arg23, a24 arg24, a25 arg25, a26 arg26, a27 arg27, a28 arg28, a29 arg29, a30 arg30, a31 arg31
+
+// forwards the parameters of a mock method to its method object
+#define SPOOKSHOW_FORWARDS_1_(a0) SPOOKSHOW_IF_EMPTY_(a0, , static_cast<decltype(arg0)&&>(arg0))
+#define SPOOKSHOW_FORWARDS_2_(a0, a1) static_cast<decltype(arg0)&&>(arg0), static_cast<decltype(arg1)&&>(arg1)
+#define SPOOKSHOW_FORWARDS_3_(a0, a1, a2) static_cast<decltype(arg0)&&>(arg0), static_cast<decltype(arg1)&&>(arg1), static_cast<decltype(arg2)&&>(arg2)
+#define SPOOKSHOW_FORWARDS_4_(a0, a1, a2, a3) static_cast<decltype(arg0)&&>(arg0), static_cast<decltype(arg1)&&>(arg1), static_cast<decltype(arg2)&&>(arg2), static_cast<decltype(arg3)&&>(arg3)
+#define SPOOKSHOW_FORWARDS_5_(a0, a1, a2, a3, a4) static_cast<decltype(arg0)&&>(arg0), static_cast<decltype(arg1)&&>(arg1), static_cast<decltype(arg2)&&>(arg2), static_cast<decltype(arg3)&&>(arg3), static_cast<decltype(arg4)&&>(arg4)
+#define SPOOKSHOW_FORWARDS_6_(a0, a1, a2, a3, a4, a5) static_cast<decltype(arg0)&&>(arg0), static_cast<decltype(arg1)&&>(arg1), static_cast<decltype(arg2)&&>(arg2), static_cast<decltype(arg3)&&>(arg3), static_cast<decltype(arg4)&&>(arg4), static_cast<decltype(arg5)&&>(arg5)
+#define SPOOKSHOW_FORWARDS_7_(a0, a1, a2, a3, a4, a5, a6) static_cast<decltype(arg0)&&>(arg0), static_cast<decltype(arg1)&&>(arg1), static_cast<decltype(arg2)&&>(arg2), static_cast<decltype(arg3)&&>(arg3), static_cast<decltype(arg4)&&>(arg4), static_cast<decltype(arg5)&&>(arg5), static_cast<decltype(arg6)&&>(arg6)
+#define SPOOKSHOW_FORWARDS_8_(a0, a1, a2, a3, a4, a5, a6, a7) static_cast<decltype(arg0)&&>(arg0), static_cast<decltype(arg1)&&>(arg1), static_cast<decltype(arg2)&&>(arg2), static_cast<decltype(arg3)&&>(arg3), static_cast<decltype(arg4)&&>(arg4), static_cast<decltype(arg5)&&>(arg5), static_cast<decltype(arg6)&&>(arg6), static_cast<decltype(arg7)&&>(arg7)
+#define SPOOKSHOW_FORWARDS_9_(a0, a1, a2, a3, a4, a5, a6, a7, a8) static_cast<decltype(arg0)&&>(arg0), static_cast<decltype(arg1)&&>(arg1), static_cast<decltype(arg2)&&>(arg2), static_cast<decltype(arg3)&&>(arg3), static_cast<decltype(arg4)&&>(arg4), static_cast<decltype(arg5)&&>(arg5), static_cast<decltype(arg6)&&>(arg6), static_cast<decltype(arg7)&&>(arg7), static_cast<decltype(arg8)&&>(arg8)
+#define SPOOKSHOW_FORWARDS_10_(a0, a1, a2, a3, a4, a5, a6, a7, a8, a9) static_cast<decltype(arg0)&&>(arg0), static_cast<decltype(arg1)&&>(arg1), static_cast<decltype(arg2)&&>(arg2), static_cast<decltype(arg3)&&>(arg3), static_cast<decltype(arg4)&&>(arg4), static_cast<decltype(arg5)&&>(arg5), static_cast<decltype(arg6)&&>(arg6), static_cast<decltype(arg7)&&>(arg7), static_cast<decltype(arg8)&&>(arg8), static_cast<decltype(arg9)&&>(arg9)
+#define SPOOKSHOW_FORWARDS_11_(a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10) static_cast<decltype(arg0)&&>(arg0), static_cast<decltype(arg1)&&>(arg1), static_cast<decltype(arg2)&&>(arg2), static_cast<decltype(arg3)&&>(arg3), static_cast<decltype(arg4)&&>(arg4), static_cast<decltype(arg5)&&>(arg5), static_cast<decltype(arg6)&&>(arg6), static_cast<decltype(arg7)&&>(arg7), static_cast<decltype(arg8)&&>(arg8), static_cast<decltype(arg9)&&>(arg9), static_cast<decltype(arg10)&&>(arg10)
+#define SPOOKSHOW_FORWARDS_12_(a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11) static_cast<decltype(arg0)&&>(arg0), static_cast<decltype(arg1)&&>(arg1), static_cast<decltype(arg2)&&>(arg2), static_cast<decltype(arg3)&&>(arg3), static_cast<decltype(arg4)&&>(arg4), static_cast<decltype(arg5)&&>(arg5), static_cast<decltype(arg6)&&>(arg6), static_cast<decltype(arg7)&&>(arg7), static_cast<decltype(arg8)&&>(arg8), static_cast<decltype(arg9)&&>(arg9), static_cast<decltype(arg10)&&>(arg10), static_cast<decltype(arg11)&&>(arg11)
+#define SPOOKSHOW_FORWARDS_13_(a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12) static_cast<decltype(arg0)&&>(arg0), static_cast<decltype(arg1)&&>(arg1), static_cast<decltype(arg2)&&>(arg2), static_cast<decltype(arg3)&&>(arg3), static_cast<decltype(arg4)&&>(arg4), static_cast<decltype(arg5)&&>(arg5), static_cast<decltype(arg6)&&>(arg6), static_cast<decltype(arg7)&&>(arg7), static_cast<decltype(arg8)&&>(arg8), static_cast<decltype(arg9)&&>(arg9), static_cast<decltype(arg10)&&>(arg10), static_cast<decltype(arg11)&&>(arg11), static_cast<decltype(arg12)&&>(arg12)
+#define SPOOKSHOW_FORWARDS_14_(a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13) static_cast<decltype(arg0)&&>(arg0), static_cast<decltype(arg1)&&>(arg1), static_cast<decltype(arg2)&&>(arg2), static_cast<decltype(arg3)&&>(arg3), static_cast<decltype(arg4)&&>(arg4), static_cast<decltype(arg5)&&>(arg5), static_cast<decltype(arg6)&&>(arg6), static_cast<decltype(arg7)&&>(arg7), static_cast<decltype(arg8)&&>(arg8), static_cast<decltype(arg9)&&>(arg9), static_cast<decltype(arg10)&&>(arg10), static_cast<decltype(arg11)&&>(arg11), static_cast<decltype(arg12)&&>(arg12), static_cast<decltype(arg13)&&>(arg13)
+#define SPOOKSHOW_FORWARDS_15_(a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14) static_cast<decltype(arg0)&&>(arg0), static_cast<decltype(arg1)&&>(arg1), static_cast<decltype(arg2)&&>(arg2), static_cast<decltype(arg3)&&>(arg3), static_cast<decltype(arg4)&&>(arg4), static_cast<decltype(arg5)&&>(arg5), static_cast<decltype(arg6)&&>(arg6), static_cast<decltype(arg7)&&>(arg7), static_cast<decltype(arg8)&&>(arg8), static_cast<decltype(arg9)&&>(arg9), static_cast<decltype(arg10)&&>(arg10), static_cast<decltype(arg11)&&>(arg11), static_cast<decltype(arg12)&&>(arg12), static_cast<decltype(arg13)&&>(arg13), static_cast<decltype(arg14)&&>(arg14)
+#define SPOOKSHOW_FORWARDS_16_(a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15) static_cast<decltype(arg0)&&>(arg0), static_cast<decltype(arg1)&&>(arg1), static_cast<decltype(arg2)&&>(arg2), static_cast<decltype(arg3)&&>(arg3), static_cast<decltype(arg4)&&>(arg4), static_cast<decltype(arg5)&&>(arg5), static_cast<decltype(arg6)&&>(arg6), static_cast<decltype(arg7)&&>(arg7), static_cast<decltype(arg8)&&>(arg8), static_cast<decltype(arg9)&&>(arg9), static_cast<decltype(arg10)&&>(arg10), static_cast<decltype(arg11)&&>(arg11), static_cast<decltype(arg12)&&>(arg12), static_cast<decltype(arg13)&&>(arg13), static_cast<decltype(arg14)&&>(arg14), static_cast<decltype(arg15)&&>(arg15)
+#define SPOOKSHOW_FORWARDS_17_(a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16) static_cast<decltype(arg0)&&>(arg0), static_cast<decltype(arg1)&&>(arg1), static_cast<decltype(arg2)&&>(arg2), static_cast<decltype(arg3)&&>(arg3), static_cast<decltype(arg4)&&>(arg4), static_cast<decltype(arg5)&&>(arg5), static_cast<decltype(arg6)&&>(arg6), static_cast<decltype(arg7)&&>(arg7), static_cast<decltype(arg8)&&>(arg8), static_cast<decltype(arg9)&&>(arg9), static_cast<decltype(arg10)&&>(arg10), static_cast<decltype(arg11)&&>(arg11), static_cast<decltype(arg12)&&>(arg12), static_cast<decltype(arg13)&&>(arg13), static_cast<decltype(arg14)&&>(arg14), static_cast<decltype(arg15)&&>(arg15), static_cast<decltype(arg16)&&>(arg16)
+#define SPOOKSHOW_FORWARDS_18_(a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17) static_cast<decltype(arg0)&&>(arg0), static_cast<decltype(arg1)&&>(arg1), static_cast<decltype(arg2)&&>(arg2), static_cast<decltype(arg3)&&>(arg3), static_cast<decltype(arg4)&&>(arg4), static_cast<decltype(arg5)&&>(arg5), static_cast<decltype(arg6)&&>(arg6), static_cast<decltype(arg7)&&>(arg7), static_cast<decltype(arg8)&&>(arg8), static_cast<decltype(arg9)&&>(arg9), static_cast<decltype(arg10)&&>(arg10), static_cast<decltype(arg11)&&>(arg11), static_cast<decltype(arg12)&&>(arg12), static_cast<decltype(arg13)&&>(arg13), static_cast<decltype(arg14)&&>(arg14), static_cast<decltype(arg15)&&>(arg15), static_cast<decltype(arg16)&&>(arg16), static_cast<decltype(arg17)&&>(arg17)
+#define SPOOKSHOW_FORWARDS_19_(a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18) static_cast<decltype(arg0)&&>(arg0), static_cast<decltype(arg1)&&>(arg1), static_cast<decltype(arg2)&&>(arg2), static_cast<decltype(arg3)&&>(arg3), static_cast<decltype(arg4)&&>(arg4), static_cast<decltype(arg5)&&>(arg5), static_cast<decltype(arg6)&&>(arg6), static_cast<decltype(arg7)&&>(arg7), static_cast<decltype(arg8)&&>(arg8), static_cast<decltype(arg9)&&>(arg9), static_cast<decltype(arg10)&&>(arg10), static_cast<decltype(arg11)&&>(arg11), static_cast<decltype(arg12)&&>(arg12), static_cast<decltype(arg13)&&>(arg13), static_cast<decltype(arg14)&&>(arg14), static_cast<decltype(arg15)&&>(arg15), static_cast<decltype(arg16)&&>(arg16), static_cast<decltype(arg17)&&>(arg17), static_cast<decltype(arg18)&&>(arg18)
+#define SPOOKSHOW_FORWARDS_20_(a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19) static_cast<decltype(arg0)&&>(arg0), static_cast<decltype(arg1)&&>(arg1), static_cast<decltype(arg2)&&>(arg2), static_cast<decltype(arg3)&&>(arg3), static_cast<decltype(arg4)&&>(arg4), static_cast<decltype(arg5)&&>(arg5), static_cast<decltype(arg6)&&>(arg6), static_cast<decltype(arg7)&&>(arg7), static_cast<decltype(arg8)&&>(arg8), static_cast<decltype(arg9)&&>(arg9), static_cast<decltype(arg10)&&>(arg10), static_cast<decltype(arg11)&&>(arg11), static_cast<decltype(arg12)&&>(arg12), static_cast<decltype(arg13)&&>(arg13), static_cast<decltype(arg14)&&>(arg14), static_cast<decltype(arg15)&&>(arg15), static_cast<decltype(arg16)&&>(arg16), static_cast<decltype(arg17)&&>(arg17), static_cast<decltype(arg18)&&>(arg18), static_cast<decltype(arg19)&&>(arg19)
+#define SPOOKSHOW_FORWARDS_21_(a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20) static_cast<decltype(arg0)&&>(arg0), static_cast<decltype(arg1)&&>(arg1), static_cast<decltype(arg2)&&>(arg2), static_cast<decltype(arg3)&&>(arg3), static_cast<decltype(arg4)&&>(arg4), static_cast<decltype(arg5)&&>(arg5), static_cast<decltype(arg6)&&>(arg6), static_cast<decltype(arg7)&&>(arg7), static_cast<decltype(arg8)&&>(arg8), static_cast<decltype(arg9)&&>(arg9), static_cast<decltype(arg10)&&>(arg10), static_cast<decltype(arg11)&&>(arg11), static_cast<decltype(arg12)&&>(arg12), static_cast<decltype(arg13)&&>(arg13), static_cast<decltype(arg14)&&>(arg14), static_cast<decltype(arg15)&&>(arg15), static_cast<decltype(arg16)&&>(arg16), static_cast<decltype(arg17)&&>(arg17), static_cast<decltype(arg18)&&>(arg18), static_cast<decltype(arg19)&&>(arg19), static_cast<decltype(arg20)&&>(arg20)
+#define SPOOKSHOW_FORWARDS_22_(a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21) static_cast<decltype(arg0)&&>(arg0), static_cast<decltype(arg1)&&>(arg1), static_cast<decltype(arg2)&&>(arg2), static_cast<decltype(arg3)&&>(arg3), static_cast<decltype(arg4)&&>(arg4), static_cast<decltype(arg5)&&>(arg5), static_cast<decltype(arg6)&&>(arg6), static_cast<decltype(arg7)&&>(arg7), static_cast<decltype(arg8)&&>(arg8), static_cast<decltype(arg9)&&>(arg9), static_cast<decltype(arg10)&&>(arg10), static_cast<decltype(arg11)&&>(arg11), static_cast<decltype(arg12)&&>(arg12), static_cast<decltype(arg13)&&>(arg13), static_cast<decltype(arg14)&&>(arg14), static_cast<decltype(arg15)&&>(arg15), static_cast<decltype(arg16)&&>(arg16), static_cast<decltype(arg17)&&>(arg17), static_cast<decltype(arg18)&&>(arg18), static_cast<decltype(arg19)&&>(arg19), static_cast<decltype(arg20)&&>(arg20), static_cast<decltype(arg21)&&>(arg21)
+#define SPOOKSHOW_FORWARDS_23_(a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22) static_cast<decltype(arg0)&&>(arg0), static_cast<decltype(arg1)&&>(arg1), static_cast<decltype(arg2)&&>(arg2), static_cast<decltype(arg3)&&>(arg3), static_cast<decltype(arg4)&&>(arg4), static_cast<decltype(arg5)&&>(arg5), static_cast<decltype(arg6)&&>(arg6), static_cast<decltype(arg7)&&>(arg7), static_cast<decltype(arg8)&&>(arg8), static_cast<decltype(arg9)&&>(arg9), static_cast<decltype(arg10)&&>(arg10), static_cast<decltype(arg11)&&>(arg11), static_cast<decltype(arg12)&&>(arg12), static_cast<decltype(arg13)&&>(arg13), static_cast<decltype(arg14)&&>(arg14), static_cast<decltype(arg15)&&>(arg15), static_cast<decltype(arg16)&&>(arg16), static_cast<decltype(arg17)&&>(arg17), static_cast<decltype(arg18)&&>(arg18), static_cast<decltype(arg19)&&>(arg19), static_cast<decltype(arg20)&&>(arg20), static_cast<decltype(arg21)&&>(arg21), static_cast<decltype(arg22)&&>(arg22)
+#define SPOOKSHOW_FORWARDS_24_(a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22, a23) static_cast<decltype(arg0)&&>(arg0), static_cast<decltype(arg1)&&>(arg1), static_cast<decltype(arg2)&&>(arg2), static_cast<decltype(arg3)&&>(arg3), static_cast<decltype(arg4)&&>(arg4), static_cast<decltype(arg5)&&>(arg5), static_cast<decltype(arg6)&&>(arg6), static_cast<decltype(arg7)&&>(arg7), static_cast<decltype(arg8)&&>(arg8), static_cast<decltype(arg9)&&>(arg9), static_cast<decltype(arg10)&&>(arg10), static_cast<decltype(arg11)&&>(arg11), static_cast<decltype(arg12)&&>(arg12), static_cast<decltype(arg13)&&>(arg13), static_cast<decltype(arg14)&&>(arg14), static_cast<decltype(arg15)&&>(arg15), static_cast<decltype(arg16)&&>(arg16), static_cast<decltype(arg17)&&>(arg17), static_cast<decltype(arg18)&&>(arg18), static_cast<decltype(arg19)&&>(arg19), static_cast<decltype(arg20)&&>(arg20), static_cast<decltype(arg21)&&>(arg21), static_cast<decltype(arg22)&&>(arg22), static_cast<decltype(arg23)&&>(arg23)
+#define SPOOKSHOW_FORWARDS_25_(a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22, a23, a24) static_cast<decltype(arg0)&&>(arg0), static_cast<decltype(arg1)&&>(arg1), static_cast<decltype(arg2)&&>(arg2), static_cast<decltype(arg3)&&>(arg3), static_cast<decltype(arg4)&&>(arg4), static_cast<decltype(arg5)&&>(arg5), static_cast<decltype(arg6)&&>(arg6), static_cast<decltype(arg7)&&>(arg7), static_cast<decltype(arg8)&&>(arg8), static_cast<decltype(arg9)&&>(arg9), static_cast<decltype(arg10)&&>(arg10), static_cast<decltype(arg11)&&>(arg11), static_cast<decltype(arg12)&&>(arg12), static_cast<decltype(arg13)&&>(arg13), static_cast<decltype(arg14)&&>(arg14), static_cast<decltype(arg15)&&>(arg15), static_cast<decltype(arg16)&&>(arg16), static_cast<decltype(arg17)&&>(arg17), static_cast<decltype(arg18)&&>(arg18), static_cast<decltype(arg19)&&>(arg19), static_cast<decltype(arg20)&&>(arg20), static_cast<decltype(arg21)&&>(arg21), static_cast<decltype(arg22)&&>(arg22), static_cast<decltype(arg23)&&>(arg23), static_cast<decltype(arg24)&&>(arg24)
+#define SPOOKSHOW_FORWARDS_26_(a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22, a23, a24, a25) static_cast<decltype(arg0)&&>(arg0), static_cast<decltype(arg1)&&>(arg1), static_cast<decltype(arg2)&&>(arg2), static_cast<decltype(arg3)&&>(arg3), static_cast<decltype(arg4)&&>(arg4), static_cast<decltype(arg5)&&>(arg5), static_cast<decltype(arg6)&&>(arg6), static_cast<decltype(arg7)&&>(arg7), static_cast<decltype(arg8)&&>(arg8), static_cast<decltype(arg9)&&>(arg9), static_cast<decltype(arg10)&&>(arg10), static_cast<decltype(arg11)&&>(arg11), static_cast<decltype(arg12)&&>(arg12), static_cast<decltype(arg13)&&>(arg13), static_cast<decltype(arg14)&&>(arg14), static_cast<decltype(arg15)&&>(arg15), static_cast<decltype(arg16)&&>(arg16), static_cast<decltype(arg17)&&>(arg17), static_cast<decltype(arg18)&&>(arg18), static_cast<decltype(arg19)&&>(arg19), static_cast<decltype(arg20)&&>(arg20), static_cast<decltype(arg21)&&>(arg21), static_cast<decltype(arg22)&&>(arg22), static_cast<decltype(arg23)&&>(arg23), static_cast<decltype(arg24)&&>(arg24), static_cast<decltype(arg25)&&>(arg25)
+#define SPOOKSHOW_FORWARDS_27_(a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22, a23, a24, a25, a26) static_cast<decltype(arg0)&&>(arg0), static_cast<decltype(arg1)&&>(arg1), static_cast<decltype(arg2)&&>(arg2), static_cast<decltype(arg3)&&>(arg3), static_cast<decltype(arg4)&&>(arg4), static_cast<decltype(arg5)&&>(arg5), static_cast<decltype(arg6)&&>(arg6), static_cast<decltype(arg7)&&>(arg7), static_cast<decltype(arg8)&&>(arg8), static_cast<decltype(arg9)&&>(arg9), static_cast<decltype(arg10)&&>(arg10), static_cast<decltype(arg11)&&>(arg11), static_cast<decltype(arg12)&&>(arg12), static_cast<decltype(arg13)&&>(arg13), static_cast<decltype(arg14)&&>(arg14), static_cast<decltype(arg15)&&>(arg15), static_cast<decltype(arg16)&&>(arg16), static_cast<decltype(arg17)&&>(arg17), static_cast<decltype(arg18)&&>(arg18), static_cast<decltype(arg19)&&>(arg19), static_cast<decltype(arg20)&&>(arg20), static_cast<decltype(arg21)&&>(arg21), static_cast<decltype(arg22)&&>(arg22), static_cast<decltype(arg23)&&>(arg23), static_cast<decltype(arg24)&&>(arg24), static_cast<decltype(arg25)&&>(arg25), static_cast<decltype(arg26)&&>(arg26)
+#define SPOOKSHOW_FORWARDS_28_(a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22, a23, a24, a25, a26, a27) static_cast<decltype(arg0)&&>(arg0), static_cast<decltype(arg1)&&>(arg1), static_cast<decltype(arg2)&&>(arg2), static_cast<decltype(arg3)&&>(arg3), static_cast<decltype(arg4)&&>(arg4), static_cast<decltype(arg5)&&>(arg5), static_cast<decltype(arg6)&&>(arg6), static_cast<decltype(arg7)&&>(arg7), static_cast<decltype(arg8)&&>(arg8), static_cast<decltype(arg9)&&>(arg9), static_cast<decltype(arg10)&&>(arg10), static_cast<decltype(arg11)&&>(arg11), static_cast<decltype(arg12)&&>(arg12), static_cast<decltype(arg13)&&>(arg13), static_cast<decltype(arg14)&&>(arg14), static_cast<decltype(arg15)&&>(arg15), static_cast<decltype(arg16)&&>(arg16), static_cast<decltype(arg17)&&>(arg17), static_cast<decltype(arg18)&&>(arg18), static_cast<decltype(arg19)&&>(arg19), static_cast<decltype(arg20)&&>(arg20), static_cast<decltype(arg21)&&>(arg21), static_cast<decltype(arg22)&&>(arg22), static_cast<decltype(arg23)&&>(arg23), static_cast<decltype(arg24)&&>(arg24), static_cast<decltype(arg25)&&>(arg25), static_cast<decltype(arg26)&&>(arg26), static_cast<decltype(arg27)&&>(arg27)
+#define SPOOKSHOW_FORWARDS_29_(a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22, a23, a24, a25, a26, a27, a28) static_cast<decltype(arg0)&&>(arg0), static_cast<decltype(arg1)&&>(arg1), static_cast<decltype(arg2)&&>(arg2), static_cast<decltype(arg3)&&>(arg3), static_cast<decltype(arg4)&&>(arg4), static_cast<decltype(arg5)&&>(arg5), static_cast<decltype(arg6)&&>(arg6), static_cast<decltype(arg7)&&>(arg7), static_cast<decltype(arg8)&&>(arg8), static_cast<decltype(arg9)&&>(arg9), static_cast<decltype(arg10)&&>(arg10), static_cast<decltype(arg11)&&>(arg11), static_cast<decltype(arg12)&&>(arg12), static_cast<decltype(arg13)&&>(arg13), static_cast<decltype(arg14)&&>(arg14), static_cast<decltype(arg15)&&>(arg15), static_cast<decltype(arg16)&&>(arg16), static_cast<decltype(arg17)&&>(arg17), static_cast<decltype(arg18)&&>(arg18), static_cast<decltype(arg19)&&>(arg19), static_cast<decltype(arg20)&&>(arg20), static_cast<decltype(arg21)&&>(arg21), static_cast<decltype(arg22)&&>(arg22), static_cast<decltype(arg23)&&>(arg23), static_cast<decltype(arg24)&&>(arg24), static_cast<decltype(arg25)&&>(arg25), static_cast<decltype(arg26)&&>(arg26), static_cast<decltype(arg27)&&>(arg27), static_cast<decltype(arg28)&&>(arg28)
+#define SPOOKSHOW_FORWARDS_30_(a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22, a23, a24, a25, a26, a27, a28, a29) static_cast<decltype(arg0)&&>(arg0), static_cast<decltype(arg1)&&>(arg1), static_cast<decltype(arg2)&&>(arg2), static_cast<decltype(arg3)&&>(arg3), static_cast<decltype(arg4)&&>(arg4), static_cast<decltype(arg5)&&>(arg5), static_cast<decltype(arg6)&&>(arg6), static_cast<decltype(arg7)&&>(arg7), static_cast<decltype(arg8)&&>(arg8), static_cast<decltype(arg9)&&>(arg9), static_cast<decltype(arg10)&&>(arg10), static_cast<decltype(arg11)&&>(arg11), static_cast<decltype(arg12)&&>(arg12), static_cast<decltype(arg13)&&>(arg13), static_cast<decltype(arg14)&&>(arg14), static_cast<decltype(arg15)&&>(arg15), static_cast<decltype(arg16)&&>(arg16), static_cast<decltype(arg17)&&>(arg17), static_cast<decltype(arg18)&&>(arg18), static_cast<decltype(arg19)&&>(arg19), static_cast<decltype(arg20)&&>(arg20), static_cast<decltype(arg21)&&>(arg21), static_cast<decltype(arg22)&&>(arg22), static_cast<decltype(arg23)&&>(arg23), static_cast<decltype(arg24)&&>(arg24), static_cast<decltype(arg25)&&>(arg25), static_cast<decltype(arg26)&&>(arg26), static_cast<decltype(arg27)&&>(arg27), static_cast<decltype(arg28)&&>(arg28), static_cast<decltype(arg29)&&>(arg29)
+#define SPOOKSHOW_FORWARDS_31_(a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22, a23, a24, a25, a26, a27, a28, a29, a30) static_cast<decltype(arg0)&&>(arg0), static_cast<decltype(arg1)&&>(arg1), static_cast<decltype(arg2)&&>(arg2), static_cast<decltype(arg3)&&>(arg3), static_cast<decltype(arg4)&&>(arg4), static_cast<decltype(arg5)&&>(arg5), static_cast<decltype(arg6)&&>(arg6), static_cast<decltype(arg7)&&>(arg7), static_cast<decltype(arg8)&&>(arg8), static_cast<decltype(arg9)&&>(arg9), static_cast<decltype(arg10)&&>(arg10), static_cast<decltype(arg11)&&>(arg11), static_cast<decltype(arg12)&&>(arg12), static_cast<decltype(arg13)&&>(arg13), static_cast<decltype(arg14)&&>(arg14), static_cast<decltype(arg15)&&>(arg15), static_cast<decltype(arg16)&&>(arg16), static_cast<decltype(arg17)&&>(arg17), static_cast<decltype(arg18)&&>(arg18), static_cast<decltype(arg19)&&>(arg19), static_cast<decltype(arg20)&&>(arg20), static_cast<decltype(arg21)&&>(arg21), static_cast<decltype(arg22)&&>(arg22), static_cast<decltype(arg23)&&>(arg23), static_cast<decltype(arg24)&&>(arg24), static_cast<decltype(arg25)&&>(arg25), static_cast<decltype(arg26)&&>(arg26), static_cast<decltype(arg27)&&>(arg27), static_cast<decltype(arg28)&&>(arg28), static_cast<decltype(arg29)&&>(arg29), static_cast<decltype(arg30)&&>(arg30)
+#define SPOOKSHOW_FORWARDS_32_(a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22, a23, a24, a25, a26, a27, a28, a29, a30, a31) static_cast<decltype(arg0)&&>(arg0), static_cast<decltype(arg1)&&>(arg1), static_cast<decltype(arg2)&&>(arg2), static_cast<decltype(arg3)&&>(arg3), static_cast<decltype(arg4)&&>(arg4), static_cast<decltype(arg5)&&>(arg5), static_cast<decltype(arg6)&&>(arg6), static_cast<decltype(arg7)&&>(arg7), static_cast<decltype(arg8)&&>(arg8), static_cast<decltype(arg9)&&>(arg9), static_cast<decltype(arg10)&&>(arg10), static_cast<decltype(arg11)&&>(arg11), static_cast<decltype(arg12)&&>(arg12), static_cast<decltype(arg13)&&>(arg13), static_cast<decltype(arg14)&&>(arg14), static_cast<decltype(arg15)&&>(arg15), static_cast<decltype(arg16)&&>(arg16), static_cast<decltype(arg17)&&>(arg17), static_cast<decltype(arg18)&&>(arg18), static_cast<decltype(arg19)&&>(arg19), static_cast<decltype(arg20)&&>(arg20), static_cast<decltype(arg21)&&>(arg21), static_cast<decltype(arg22)&&>(arg22), static_cast<decltype(arg23)&&>(arg23), static_cast<decltype(arg24)&&>(arg24), static_cast<decltype(arg25)&&>(arg25), static_cast<decltype(arg26)&&>(arg26), static_cast<decltype(arg27)&&>(arg27), static_cast<decltype(arg28)&&>(arg28), static_cast<decltype(arg29)&&>(arg29), static_cast<decltype(arg30)&&>(arg30), static_cast<decltype(arg31)&&>(arg31)
+
+// declares a mock method for each (ret, meth, (args), (qualifiers)) tuple
+#define SPOOKSHOW_MOCK_METHODS_1_(m) SPOOKSHOW_MOCK_METHOD m;
+#define SPOOKSHOW_MOCK_METHODS_2_(m, ...) SPOOKSHOW_MOCK_METHOD m; SPOOKSHOW_MOCK_METHODS_1_(__VA_ARGS__)
+#define SPOOKSHOW_MOCK_METHODS_3_(m, ...) SPOOKSHOW_MOCK_METHOD m; SPOOKSHOW_MOCK_METHODS_2_(__VA_ARGS__)
+#define SPOOKSHOW_MOCK_METHODS_4_(m, ...) SPOOKSHOW_MOCK_METHOD m; SPOOKSHOW_MOCK_METHODS_3_(__VA_ARGS__)
+#define SPOOKSHOW_MOCK_METHODS_5_(m, ...) SPOOKSHOW_MOCK_METHOD m; SPOOKSHOW_MOCK_METHODS_4_(__VA_ARGS__)
+#define SPOOKSHOW_MOCK_METHODS_6_(m, ...) SPOOKSHOW_MOCK_METHOD m; SPOOKSHOW_MOCK_METHODS_5_(__VA_ARGS__)
+#define SPOOKSHOW_MOCK_METHODS_7_(m, ...) SPOOKSHOW_MOCK_METHOD m; SPOOKSHOW_MOCK_METHODS_6_(__VA_ARGS__)
+#define SPOOKSHOW_MOCK_METHODS_8_(m, ...) SPOOKSHOW_MOCK_METHOD m; SPOOKSHOW_MOCK_METHODS_7_(__VA_ARGS__)
+#define SPOOKSHOW_MOCK_METHODS_9_(m, ...) SPOOKSHOW_MOCK_METHOD m; SPOOKSHOW_MOCK_METHODS_8_(__VA_ARGS__)
+#define SPOOKSHOW_MOCK_METHODS_10_(m, ...) SPOOKSHOW_MOCK_METHOD m; SPOOKSHOW_MOCK_METHODS_9_(__VA_ARGS__)
+#define SPOOKSHOW_MOCK_METHODS_11_(m, ...) SPOOKSHOW_MOCK_METHOD m; SPOOKSHOW_MOCK_METHODS_10_(__VA_ARGS__)
+#define SPOOKSHOW_MOCK_METHODS_12_(m, ...) SPOOKSHOW_MOCK_METHOD m; SPOOKSHOW_MOCK_METHODS_11_(__VA_ARGS__)
+#define SPOOKSHOW_MOCK_METHODS_13_(m, ...) SPOOKSHOW_MOCK_METHOD m; SPOOKSHOW_MOCK_METHODS_12_(__VA_ARGS__)
+#define SPOOKSHOW_MOCK_METHODS_14_(m, ...) SPOOKSHOW_MOCK_METHOD m; SPOOKSHOW_MOCK_METHODS_13_(__VA_ARGS__)
+#define SPOOKSHOW_MOCK_METHODS_15_(m, ...) SPOOKSHOW_MOCK_METHOD m; SPOOKSHOW_MOCK_METHODS_14_(__VA_ARGS__)
+#define SPOOKSHOW_MOCK_METHODS_16_(m, ...) SPOOKSHOW_MOCK_METHOD m; SPOOKSHOW_MOCK_METHODS_15_(__VA_ARGS__)
+#define SPOOKSHOW_MOCK_METHODS_17_(m, ...) SPOOKSHOW_MOCK_METHOD m; SPOOKSHOW_MOCK_METHODS_16_(__VA_ARGS__)
+#define SPOOKSHOW_MOCK_METHODS_18_(m, ...) SPOOKSHOW_MOCK_METHOD m; SPOOKSHOW_MOCK_METHODS_17_(__VA_ARGS__)
+#define SPOOKSHOW_MOCK_METHODS_19_(m, ...) SPOOKSHOW_MOCK_METHOD m; SPOOKSHOW_MOCK_METHODS_18_(__VA_ARGS__)
+#define SPOOKSHOW_MOCK_METHODS_20_(m, ...) SPOOKSHOW_MOCK_METHOD m; SPOOKSHOW_MOCK_METHODS_19_(__VA_ARGS__)
+#define SPOOKSHOW_MOCK_METHODS_21_(m, ...) SPOOKSHOW_MOCK_METHOD m; SPOOKSHOW_MOCK_METHODS_20_(__VA_ARGS__)
+#define SPOOKSHOW_MOCK_METHODS_22_(m, ...) SPOOKSHOW_MOCK_METHOD m; SPOOKSHOW_MOCK_METHODS_21_(__VA_ARGS__)
+#define SPOOKSHOW_MOCK_METHODS_23_(m, ...) SPOOKSHOW_MOCK_METHOD m; SPOOKSHOW_MOCK_METHODS_22_(__VA_ARGS__)
+#define SPOOKSHOW_MOCK_METHODS_24_(m, ...) SPOOKSHOW_MOCK_METHOD m; SPOOKSHOW_MOCK_METHODS_23_(__VA_ARGS__)
+#define SPOOKSHOW_MOCK_METHODS_25_(m, ...) SPOOKSHOW_MOCK_METHOD m; SPOOKSHOW_MOCK_METHODS_24_(__VA_ARGS__)
+#define SPOOKSHOW_MOCK_METHODS_26_(m, ...) SPOOKSHOW_MOCK_METHOD m; SPOOKSHOW_MOCK_METHODS_25_(__VA_ARGS__)
+#define SPOOKSHOW_MOCK_METHODS_27_(m, ...) SPOOKSHOW_MOCK_METHOD m; SPOOKSHOW_MOCK_METHODS_26_(__VA_ARGS__)
+#define SPOOKSHOW_MOCK_METHODS_28_(m, ...) SPOOKSHOW_MOCK_METHOD m; SPOOKSHOW_MOCK_METHODS_27_(__VA_ARGS__)
+#define SPOOKSHOW_MOCK_METHODS_29_(m, ...) SPOOKSHOW_MOCK_METHOD m; SPOOKSHOW_MOCK_METHODS_28_(__VA_ARGS__)
+#define SPOOKSHOW_MOCK_METHODS_30_(m, ...) SPOOKSHOW_MOCK_METHOD m; SPOOKSHOW_MOCK_METHODS_29_(__VA_ARGS__)
+#define SPOOKSHOW_MOCK_METHODS_31_(m, ...) SPOOKSHOW_MOCK_METHOD m; SPOOKSHOW_MOCK_METHODS_30_(__VA_ARGS__)
+#define SPOOKSHOW_MOCK_METHODS_32_(m, ...) SPOOKSHOW_MOCK_METHOD m; SPOOKSHOW_MOCK_METHODS_31_(__VA_ARGS__)
+
+// mock method implementation
+
+// joins up to five qualifiers, for example (const, noexcept) becomes const noexcept
+#define SPOOKSHOW_QUALIFIERS_(...)								\
+  SPOOKSHOW_QUALIFIERS_JOIN_(__VA_ARGS__, , , , , )
+#define SPOOKSHOW_QUALIFIERS_JOIN_(q0, q1, q2, q3, q4, ...)					\
+  q0 q1 q2 q3 q4
+
+#define SPOOKSHOW_METHOD_DESCRIPTOR_IMPL_(ret, meth, params, quals)				\
+  static const spookshow::internal::method_descriptor& SPOOKSHOW_METHOD_DESCRIPTOR_(meth)()	\
+  {												\
+    static constexpr spookshow::internal::method_descriptor descriptor {			\
+      #meth, #ret " " #meth params, quals, __FILE__, __LINE__					\
+    };												\
+    return descriptor;										\
+  }
+
+// fixed-arity forms, expanded by hand so that they do not need any of the counting above
+
 #define SPOOKSHOW_MOCK_METHOD_0_IMPL_(ret, meth, cvqual)					\
   virtual ret meth(void) cvqual override							\
   {												\
-    SPOOKSHOW_METHOD_OBJECT_(meth).set_name(__PRETTY_FUNCTION__);				\
     return SPOOKSHOW_METHOD_OBJECT_(meth).invoke();						\
   }												\
-  spookshow::internal::method<ret()> SPOOKSHOW_METHOD_OBJECT_(meth) { #meth }
+  SPOOKSHOW_METHOD_DESCRIPTOR_IMPL_(ret, meth, "()", #cvqual)					\
+  spookshow::internal::method<ret(), spookshow_inline_capacity_::value>			\
+    SPOOKSHOW_METHOD_OBJECT_(meth) { SPOOKSHOW_METHOD_DESCRIPTOR_(meth)() }
 
 #define SPOOKSHOW_MOCK_METHOD_1_IMPL_(ret, meth, cvqual, t0)					\
   virtual ret meth(t0 arg0) cvqual override							\
   {												\
-    SPOOKSHOW_METHOD_OBJECT_(meth).set_name(__PRETTY_FUNCTION__);				\
-    return SPOOKSHOW_METHOD_OBJECT_(meth).invoke(arg0);						\
+    return SPOOKSHOW_METHOD_OBJECT_(meth).invoke(static_cast<decltype(arg0)&&>(arg0));			\
   }												\
-  spookshow::internal::method<ret(t0)> SPOOKSHOW_METHOD_OBJECT_(meth) { #meth }
+  SPOOKSHOW_METHOD_DESCRIPTOR_IMPL_(ret, meth, "(" #t0 ")", #cvqual)				\
+  spookshow::internal::method<ret(t0), spookshow_inline_capacity_::value>			\
+    SPOOKSHOW_METHOD_OBJECT_(meth) { SPOOKSHOW_METHOD_DESCRIPTOR_(meth)() }
 
 #define SPOOKSHOW_MOCK_METHOD_2_IMPL_(ret, meth, cvqual, t0, t1)				\
   virtual ret meth(t0 arg0, t1 arg1) cvqual override						\
   {												\
-    SPOOKSHOW_METHOD_OBJECT_(meth).set_name(__PRETTY_FUNCTION__);				\
-    return SPOOKSHOW_METHOD_OBJECT_(meth).invoke(arg0, arg1);					\
+    return SPOOKSHOW_METHOD_OBJECT_(meth).invoke(static_cast<decltype(arg0)&&>(arg0),			\
+                                                 static_cast<decltype(arg1)&&>(arg1));			\
   }												\
-  spookshow::internal::method<ret(t0, t1)> SPOOKSHOW_METHOD_OBJECT_(meth) { #meth }
+  SPOOKSHOW_METHOD_DESCRIPTOR_IMPL_(ret, meth, "(" #t0 ", " #t1 ")", #cvqual)			\
+  spookshow::internal::method<ret(t0, t1), spookshow_inline_capacity_::value>			\
+    SPOOKSHOW_METHOD_OBJECT_(meth) { SPOOKSHOW_METHOD_DESCRIPTOR_(meth)() }
 
-#define SPOOKSHOW_MOCK_METHOD_3_IMPL_(ret, meth, cvqual, t0, t1, t2) 				\
+#define SPOOKSHOW_MOCK_METHOD_3_IMPL_(ret, meth, cvqual, t0, t1, t2)				\
   virtual ret meth(t0 arg0, t1 arg1, t2 arg2) cvqual override					\
   {												\
-    SPOOKSHOW_METHOD_OBJECT_(meth).set_name(__PRETTY_FUNCTION__);				\
-    return SPOOKSHOW_METHOD_OBJECT_(meth).invoke(arg0, arg1, arg2);				\
+    return SPOOKSHOW_METHOD_OBJECT_(meth).invoke(static_cast<decltype(arg0)&&>(arg0),			\
+                                                 static_cast<decltype(arg1)&&>(arg1),			\
+                                                 static_cast<decltype(arg2)&&>(arg2));			\
   }												\
-  spookshow::internal::method<ret(t0, t1, t2)> SPOOKSHOW_METHOD_OBJECT_(meth) { #meth }
+  SPOOKSHOW_METHOD_DESCRIPTOR_IMPL_(ret, meth, "(" #t0 ", " #t1 ", " #t2 ")", #cvqual)		\
+  spookshow::internal::method<ret(t0, t1, t2), spookshow_inline_capacity_::value>			\
+    SPOOKSHOW_METHOD_OBJECT_(meth) { SPOOKSHOW_METHOD_DESCRIPTOR_(meth)() }
 
-#define SPOOKSHOW_MOCK_METHOD_4_IMPL_(ret, meth, cvqual, t0, t1, t2, t3) 			\
+#define SPOOKSHOW_MOCK_METHOD_4_IMPL_(ret, meth, cvqual, t0, t1, t2, t3)			\
   virtual ret meth(t0 arg0, t1 arg1, t2 arg2, t3 arg3) cvqual override				\
   {												\
-    SPOOKSHOW_METHOD_OBJECT_(meth).set_name(__PRETTY_FUNCTION__);				\
-    return SPOOKSHOW_METHOD_OBJECT_(meth).invoke(arg0, arg1, arg2, arg3);			\
+    return SPOOKSHOW_METHOD_OBJECT_(meth).invoke(static_cast<decltype(arg0)&&>(arg0),			\
+                                                 static_cast<decltype(arg1)&&>(arg1),			\
+                                                 static_cast<decltype(arg2)&&>(arg2),			\
+                                                 static_cast<decltype(arg3)&&>(arg3));			\
+  }												\
+  SPOOKSHOW_METHOD_DESCRIPTOR_IMPL_(ret, meth, "(" #t0 ", " #t1 ", " #t2 ", " #t3 ")", #cvqual)	\
+  spookshow::internal::method<ret(t0, t1, t2, t3), spookshow_inline_capacity_::value>			\
+    SPOOKSHOW_METHOD_OBJECT_(meth) { SPOOKSHOW_METHOD_DESCRIPTOR_(meth)() }
+
+#define SPOOKSHOW_MOCK_METHOD_5_IMPL_(ret, meth, cvqual, t0, t1, t2, t3, t4)			\
+  virtual ret meth(t0 arg0, t1 arg1, t2 arg2, t3 arg3, t4 arg4) cvqual override			\
+  {												\
+    return SPOOKSHOW_METHOD_OBJECT_(meth).invoke(static_cast<decltype(arg0)&&>(arg0),			\
+                                                 static_cast<decltype(arg1)&&>(arg1),			\
+                                                 static_cast<decltype(arg2)&&>(arg2),			\
+                                                 static_cast<decltype(arg3)&&>(arg3),			\
+                                                 static_cast<decltype(arg4)&&>(arg4));			\
   }												\
-  spookshow::internal::method<ret(t0, t1, t2, t3)> SPOOKSHOW_METHOD_OBJECT_(meth) { #meth }
+  SPOOKSHOW_METHOD_DESCRIPTOR_IMPL_(ret, meth, "(" #t0 ", " #t1 ", " #t2 ", " #t3 ", " #t4 ")", #cvqual)	\
+  spookshow::internal::method<ret(t0, t1, t2, t3, t4), spookshow_inline_capacity_::value>			\
+    SPOOKSHOW_METHOD_OBJECT_(meth) { SPOOKSHOW_METHOD_DESCRIPTOR_(meth)() }
+
+// variadic form, which receives the parameter count and joined qualifiers already expanded
 
-#define SPOOKSHOW_MOCK_METHOD_5_IMPL_(ret, meth, cvqual, t0, t1, t2, t3, t4) 			\
-  virtual ret meth(t0 arg0, t1 arg1, t2 arg2, t3 arg3, t4 arg4) cvqual override 		\
+#define SPOOKSHOW_MOCK_METHOD_IMPL_(ret, meth, args, arity, quals)				\
+  virtual ret meth(SPOOKSHOW_PARAMETERS_ ## arity ## _ args) quals override			\
   {												\
-    SPOOKSHOW_METHOD_OBJECT_(meth).set_name(__PRETTY_FUNCTION__);				\
-    return SPOOKSHOW_METHOD_OBJECT_(meth).invoke(arg0, arg1, arg2, arg3, arg4);			\
+    return SPOOKSHOW_METHOD_OBJECT_(meth).invoke(SPOOKSHOW_FORWARDS_ ## arity ## _ args);	\
   }												\
-  spookshow::internal::method<ret(t0, t1, t2, t3, t4)> SPOOKSHOW_METHOD_OBJECT_(meth) { #meth }
+  SPOOKSHOW_METHOD_DESCRIPTOR_IMPL_(ret, meth, #args, #quals)					\
+  spookshow::internal::method<ret args, spookshow_inline_capacity_::value>			\
+    SPOOKSHOW_METHOD_OBJECT_(meth) { SPOOKSHOW_METHOD_DESCRIPTOR_(meth)() }
+
+// counts the parameters and joins the qualifiers (which are optional) for SPOOKSHOW_MOCK_METHOD
+#define SPOOKSHOW_MOCK_METHOD_SELECT_(ret, meth, args, quals, ...)				\
+  SPOOKSHOW_MOCK_METHOD_EXPAND_(ret, meth, args, SPOOKSHOW_NARG_ args, SPOOKSHOW_QUALIFIERS_ quals)
+#define SPOOKSHOW_MOCK_METHOD_EXPAND_(...)							\
+  SPOOKSHOW_MOCK_METHOD_IMPL_(__VA_ARGS__)
 
 // http://stackoverflow.com/a/17624752/434245
 #define SPOOKSHOW_UNIQUE_(base, counter)							\
@@ -85,6 +279,38 @@
 #define SPOOKSHOW(obj, meth)									\
   ((obj).SPOOKSHOW_METHOD_OBJECT_(meth))
 
+/**
+ * Sets the number of bytes of inline storage used for the actions and conditions of the mocks in a
+ * class. If used, this must appear before any of the `SPOOKSHOW_MOCK_*` macros in the class.
+ */
+#define SPOOKSHOW_INLINE_CAPACITY(bytes)							\
+  using spookshow_inline_capacity_ = std::integral_constant<std::size_t, bytes>
+
+/**
+ * Creates a mock for a method with any number of arguments (up to 32).
+ *
+ * Usage is `SPOOKSHOW_MOCK_METHOD(ret, meth, (args...))` or
+ * `SPOOKSHOW_MOCK_METHOD(ret, meth, (args...), (qualifiers...))`, where the qualifiers may include
+ * `const`, `noexcept` and ref-qualifiers (for example `(const, noexcept)` or `(&&)`). `override`
+ * is always added. Types containing commas must be given an alias first.
+ */
+#define SPOOKSHOW_MOCK_METHOD(...)								\
+  SPOOKSHOW_MOCK_METHOD_SELECT_(__VA_ARGS__, (), )
+
+/**
+ * Creates mocks for several methods at once (up to 32).
+ *
+ * Each argument is a parenthesized list of arguments for `SPOOKSHOW_MOCK_METHOD`, for example:
+ *
+ *     SPOOKSHOW_MOCK_METHODS(
+ *       (void, start, ()),
+ *       (int, read, (char*, std::size_t), (noexcept)),
+ *       (bool, running, (), (const)));
+ */
+#define SPOOKSHOW_MOCK_METHODS(...)								\
+  SPOOKSHOW_CAT_(SPOOKSHOW_MOCK_METHODS_, SPOOKSHOW_CAT_(SPOOKSHOW_NARG_(__VA_ARGS__), _))	\
+    (__VA_ARGS__) static_assert(true, "")
+
 /**
  * Creates a mock for a non-`const` method with no arguments.
  */
@@ -8,15 +8,47 @@
 
 /* -- Includes -- */
 
-#include <algorithm>
-#include <functional>
-#include <iostream>
+#include <cstddef>
+#include <initializer_list>
+#include <iosfwd>
+#include <iterator>
+#include <limits>
 #include <memory>
-#include <sstream>
 #include <string>
-#include <vector>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 
 #include <spookshow/spookshow.hpp>
+#include <spookshow/call_log.hpp>
+#include <spookshow/flat_hash_map.hpp>
+#include <spookshow/inline_function.hpp>
+#include <spookshow/method_core.hpp>
+
+/* -- Macros -- */
+
+// the common signatures which are instantiated in the library, shared by the extern declarations
+// below and the explicit instantiations in src/method.cpp so that the two cannot drift apart
+#define SPOOKSHOW_COMMON_INSTANTIATIONS_(instantiate)						\
+  instantiate(inline_function, void())								\
+  instantiate(inline_function, bool())								\
+  instantiate(inline_function, int())								\
+  instantiate(inline_function, void(bool))							\
+  instantiate(inline_function, void(int))							\
+  instantiate(inline_function, int(int))							\
+  instantiate(inline_function, bool(int))							\
+  instantiate(inline_function, void(int, int))							\
+  instantiate(inline_function, bool(const bool&))						\
+  instantiate(inline_function, bool(const int&))						\
+  instantiate(inline_function, bool(const int&, const int&))					\
+  instantiate(method, void())									\
+  instantiate(method, bool())									\
+  instantiate(method, int())									\
+  instantiate(method, void(bool))								\
+  instantiate(method, void(int))								\
+  instantiate(method, int(int))									\
+  instantiate(method, bool(int))								\
+  instantiate(method, void(int, int))
 
 /* -- Types -- */
 
@@ -43,46 +75,638 @@ namespace spookshow
 	: m_value(value)
       { }
 
+      explicit returns_token(TValue&& value)
+	: m_value(std::move(value))
+      { }
+
       /** Returns the value. */
-      TValue value() const
+      const TValue& value() const
       {
 	return m_value;
       }
 
+      /** Moves the value out of the token. */
+      TValue&& take()
+      {
+	return std::move(m_value);
+      }
+
+    private:
+      TValue m_value;
+    };
+
+    /**
+     * Token for returning a reference to an object owned by the caller.
+     */
+    template <typename TValue>
+    class returns_ref_token final
+    {
+    public:
+
+      explicit returns_ref_token(TValue& object)
+	: m_object(&object)
+      { }
+
+      /** Returns the object. */
+      TValue& object() const
+      {
+	return *m_object;
+      }
+
+    private:
+      TValue* m_object;
+    };
+
+    /**
+     * Functor returning a copy of a value which is shared by all copies of the functor.
+     *
+     * Copying the functor (e.g., to call it outside of the queue lock in concurrent mode) only
+     * copies a pointer, so the value itself is copied at most once per call.
+     */
+    template <typename TValue>
+    class shared_value final
+    {
+    public:
+
+      explicit shared_value(TValue&& value)
+        : m_value(std::make_shared<const TValue>(std::move(value)))
+      { }
+
+      template <typename... TArgs>
+      const TValue& operator ()(TArgs&&...) const
+      {
+        return *m_value;
+      }
+
+    private:
+      std::shared_ptr<const TValue> m_value;
+    };
+
+    /**
+     * Functor returning a copy of a value which is small and trivially copyable, so it is cheaper
+     * to store inline than to share.
+     */
+    template <typename TValue>
+    class inline_value final
+    {
+    public:
+
+      explicit inline_value(TValue&& value)
+        : m_value(std::move(value))
+      { }
+
+      template <typename... TArgs>
+      TValue operator ()(TArgs&&...) const
+      {
+        return m_value;
+      }
+
     private:
       TValue m_value;
     };
 
+    /**
+     * Selects the functor used to return a value any number of times.
+     */
+    template <typename TValue>
+    using repeated_value = std::conditional_t<std::is_trivially_copyable<TValue>::value && sizeof(TValue) <= 2 * sizeof(void*),
+                                              inline_value<TValue>,
+                                              shared_value<TValue>>;
+
+    /**
+     * Token for returning each value of a sequence in turn.
+     */
+    template <typename TValue>
+    class returns_each_token final
+    {
+    public:
+
+      template <typename TIterator>
+      returns_each_token(TIterator first, TIterator last)
+      {
+        m_values.reserve(static_cast<std::size_t>(std::distance(first, last)));
+        for (; first != last; ++first)
+          m_values.emplace_back(*first);
+      }
+
+      /** Returns the values. */
+      spookshow::internal::compact_vector<TValue>& values()
+      {
+        return m_values;
+      }
+
+    private:
+      spookshow::internal::compact_vector<TValue> m_values;
+    };
+
+    /**
+     * Provides the result of a mock method call which failed.
+     *
+     * Methods returning values (or nothing) return a value-initialized object, so this class is
+     * empty for them.
+     */
+    template <typename TRet, typename = void>
+    class default_result_storage
+    {
+    protected:
+
+      TRet default_result() const
+      {
+        return TRet();
+      }
+
+    };
+
+    /**
+     * Provides the result of a mock method call which failed, for methods returning references.
+     *
+     * Each method owns the object it returns a reference to, which is created by the first failed
+     * call. It is value-initialized again by each failed call (if it can be assigned), so writes
+     * through the reference do not leak into later calls, or into other methods.
+     */
+    template <typename TRet>
+    class default_result_storage<TRet, std::enable_if_t<std::is_reference<TRet>::value>>
+    {
+    private:
+
+      using object_type = std::remove_cv_t<std::remove_reference_t<TRet>>;
+
+    protected:
+
+      TRet default_result() const
+      {
+        if (!m_object)
+          m_object.reset(new object_type());
+        else
+          reinitialize(std::is_move_assignable<object_type>());
+        return static_cast<TRet>(*m_object);
+      }
+
+    private:
+
+      void reinitialize(std::true_type) const
+      {
+        *m_object = object_type();
+      }
+
+      void reinitialize(std::false_type) const
+      { }
+
+      mutable std::unique_ptr<object_type> m_object;
+
+    };
+
+    /**
+     * Storage for a value pulled from a return stream, which is constructed in place by the stream.
+     *
+     * The value is only constructed if the call succeeds, so the return type of the method does
+     * not need to be default-constructible or assignable.
+     */
+    template <typename TValue>
+    class stream_slot final
+    {
+    public:
+
+      stream_slot()
+        : m_constructed(false)
+      { }
+
+      ~stream_slot()
+      {
+        if (m_constructed)
+          value().~TValue();
+      }
+
+    private:
+
+      stream_slot(const stream_slot&) = delete;
+      stream_slot& operator =(const stream_slot&) = delete;
+
+    public:
+
+      /** Constructs the value. The slot must be empty. */
+      template <typename... TArgs>
+      void emplace(TArgs&&... args)
+      {
+        new (&m_storage) TValue(std::forward<TArgs>(args)...);
+        m_constructed = true;
+      }
+
+      /** Returns `true` if the value has been constructed. */
+      bool has_value() const
+      {
+        return m_constructed;
+      }
+
+      /** Returns the value, which must have been constructed. */
+      TValue& value()
+      {
+        return *reinterpret_cast<TValue*>(&m_storage);
+      }
+
+    private:
+      std::aligned_storage_t<sizeof(TValue), alignof(TValue)> m_storage;
+      bool m_constructed;
+    };
+
+    /**
+     * Returns a value pulled from a return stream.
+     *
+     * Streams can only be enqueued for methods returning values, but calls to them must still
+     * compile for other methods.
+     */
+    template <typename TRet, typename TValue>
+    inline TRet stream_result(TValue& value, std::true_type)
+    {
+      return std::move(value);
+    }
+
+    template <typename TRet, typename TValue>
+    inline TRet stream_result(TValue&, std::false_type)
+    {
+      spookshow::internal::handle_error("Return stream used by a method which does not return values!");
+    }
+
+    /**
+     * Functor returning each value of a sequence in turn.
+     *
+     * The values are stored in a single block, and each one is moved out as it is returned. The
+     * functor is move-only, so it is always called in place and never loses its position.
+     */
+    template <typename TValue>
+    class value_sequence final
+    {
+    public:
+
+      explicit value_sequence(spookshow::internal::compact_vector<TValue>&& values)
+        : m_values(std::move(values)),
+          m_next(0)
+      { }
+
+      template <typename... TArgs>
+      TValue operator ()(TArgs&&...)
+      {
+        return std::move(m_values[m_next++]);
+      }
+
+    private:
+      spookshow::internal::compact_vector<TValue> m_values;
+      std::size_t m_next;
+    };
+
+    /**
+     * Return stream calling a generator for each value. The stream never ends.
+     */
+    template <typename TGenerator>
+    class generator_stream final
+    {
+    public:
+
+      explicit generator_stream(TGenerator generator)
+        : m_generator(std::move(generator))
+      { }
+
+      template <typename TValue>
+      bool operator ()(spookshow::internal::stream_slot<TValue>* slot)
+      {
+        if (slot)
+          slot->emplace(m_generator());
+        return true;
+      }
+
+    private:
+      TGenerator m_generator;
+    };
+
+    /**
+     * Return stream reading each value from an iterator range. The stream ends with the range.
+     */
+    template <typename TIterator>
+    class iterator_stream final
+    {
+    public:
+
+      iterator_stream(TIterator first, TIterator last)
+        : m_first(std::move(first)),
+          m_last(std::move(last))
+      { }
+
+      template <typename TValue>
+      bool operator ()(spookshow::internal::stream_slot<TValue>* slot)
+      {
+        if (m_first == m_last)
+          return false;
+        if (slot)
+        {
+          slot->emplace(*m_first);
+          ++m_first;
+        }
+        return true;
+      }
+
+    private:
+      TIterator m_first;
+      TIterator m_last;
+    };
+
+    /**
+     * Token for returning values pulled from a stream.
+     */
+    template <typename TStream>
+    class returns_from_token final
+    {
+    public:
+
+      returns_from_token(TStream stream, spookshow::stream_end end)
+        : m_stream(std::move(stream)),
+          m_end(end)
+      { }
+
+      /** Returns the stream. */
+      TStream& stream()
+      {
+        return m_stream;
+      }
+
+      /** Returns how calls are handled once the stream ends. */
+      spookshow::stream_end end() const
+      {
+        return m_end;
+      }
+
+    private:
+      TStream m_stream;
+      spookshow::stream_end m_end;
+    };
+
+    /**
+     * Compile-time description of a mocked method.
+     *
+     * Each mock method generated by the `SPOOKSHOW_MOCK_*` macros owns a single static instance of
+     * this class. It only holds pointers to string literals, so it costs nothing to attach and the
+     * human-readable name is only assembled when a failure message is actually built.
+     */
+    class method_descriptor final
+    {
+    public:
+
+      /** The bare name of the method. */
+      const char* const name;
+
+      /** The return type, name and parameter list of the method. */
+      const char* const signature;
+
+      /** The qualifiers of the method (may be empty). */
+      const char* const qualifiers;
+
+      /** The source file in which the mock was declared. */
+      const char* const file;
+
+      /** The line on which the mock was declared. */
+      const int line;
+
+    };
+
+    /**
+     * Writes a human-readable description of a mocked method to a stream.
+     */
+    std::ostream& operator <<(std::ostream& stream, const method_descriptor& descriptor);
+
+    /**
+     * Writes a value of a fundamental type to a stream.
+     *
+     * These are defined in the library, so this header only needs `<iosfwd>`.
+     */
+    void write_value(std::ostream& stream, bool value);
+    void write_value(std::ostream& stream, char value);
+    void write_value(std::ostream& stream, signed char value);
+    void write_value(std::ostream& stream, unsigned char value);
+    void write_value(std::ostream& stream, long long value);
+    void write_value(std::ostream& stream, unsigned long long value);
+    void write_value(std::ostream& stream, double value);
+    void write_value(std::ostream& stream, long double value);
+    void write_value(std::ostream& stream, const void* value);
+    void write_value(std::ostream& stream, const std::string& value);
+
+    /**
+     * Writes a string literal to a stream.
+     */
+    void write_text(std::ostream& stream, const char* text);
+
+    /**
+     * Trait determining whether a non-member `operator <<` writing a type to a stream is visible.
+     *
+     * Using function call syntax means only non-member operators are found, and those can be
+     * called through an incomplete `std::ostream`.
+     */
+    template <typename T, typename = void>
+    class has_stream_operator : public std::false_type { };
+
+    template <typename T>
+    class has_stream_operator<T, decltype(void(operator <<(std::declval<std::ostream&>(), std::declval<const T&>())))>
+      : public std::true_type { };
+
+    /**
+     * Enumeration of the ways in which an argument of a failed call can be written to a stream.
+     */
+    enum class argument_format
+    {
+      unprintable,
+      arithmetic,
+      pointer,
+      string,
+      stream_operator,
+      enumeration,
+    };
+
+    template <argument_format Format>
+    using argument_format_tag = std::integral_constant<argument_format, Format>;
+
+    /**
+     * Returns the tag for the way in which an argument of type `T` is written.
+     */
+    template <typename T>
+    constexpr argument_format argument_format_of()
+    {
+      return (std::is_arithmetic<T>::value ? argument_format::arithmetic :
+              (std::is_pointer<T>::value && std::is_object<std::remove_pointer_t<T>>::value) ? argument_format::pointer :
+              std::is_same<T, std::string>::value ? argument_format::string :
+              has_stream_operator<T>::value ? argument_format::stream_operator :
+              std::is_enum<T>::value ? argument_format::enumeration :
+              argument_format::unprintable);
+    }
+
+    /**
+     * Type which an arithmetic argument is converted to before being written.
+     */
+    template <typename T>
+    using written_arithmetic_type =
+      std::conditional_t<(std::is_same<T, bool>::value ||
+                          std::is_same<T, char>::value ||
+                          std::is_same<T, signed char>::value ||
+                          std::is_same<T, unsigned char>::value ||
+                          std::is_same<T, long double>::value), T,
+      std::conditional_t<std::is_floating_point<T>::value, double,
+      std::conditional_t<std::is_signed<T>::value, long long, unsigned long long>>>;
+
+    template <typename T>
+    void write_argument(std::ostream& stream, const T& argument, argument_format_tag<argument_format::arithmetic>)
+    {
+      spookshow::internal::write_value(stream, static_cast<written_arithmetic_type<T>>(argument));
+    }
+
+    template <typename T>
+    void write_argument(std::ostream& stream, const T& argument, argument_format_tag<argument_format::pointer>)
+    {
+      // pointers (including `char*`) are not dereferenced, since they may not be valid
+      spookshow::internal::write_value(stream, const_cast<const void*>(static_cast<const volatile void*>(argument)));
+    }
+
+    template <typename T>
+    void write_argument(std::ostream& stream, const T& argument, argument_format_tag<argument_format::string>)
+    {
+      spookshow::internal::write_value(stream, argument);
+    }
+
+    template <typename T>
+    void write_argument(std::ostream& stream, const T& argument, argument_format_tag<argument_format::stream_operator>)
+    {
+      operator <<(stream, argument);
+    }
+
+    template <typename T>
+    void write_argument(std::ostream& stream, const T& argument, argument_format_tag<argument_format::enumeration>)
+    {
+      using underlying = std::underlying_type_t<T>;
+      spookshow::internal::write_value(stream, static_cast<written_arithmetic_type<underlying>>(argument));
+    }
+
+    template <typename T>
+    void write_argument(std::ostream& stream, const T&, argument_format_tag<argument_format::unprintable>)
+    {
+      spookshow::internal::write_text(stream, "?");
+    }
+
+    /**
+     * Writes an argument of a failed call to a stream, preceded by a separator if required.
+     */
+    template <typename T>
+    void write_argument(std::ostream& stream, const T& argument, std::size_t position)
+    {
+      if (position != 0)
+        spookshow::internal::write_text(stream, ", ");
+      write_argument(stream, argument, argument_format_tag<argument_format_of<T>()>());
+    }
+
     // required to use "function" syntax in class template
-    template <typename TRet, typename... TArgs>
+    template <typename TSignature, std::size_t Capacity = DEFAULT_INLINE_CAPACITY>
     class method;
 
     /**
      * Object providing functionality for mocking a method.
+     *
+     * Actions and conditions are stored in `inline_function` objects with `Capacity` bytes of
+     * inline storage, so enqueuing typical actions does not allocate. Everything which does not
+     * depend on the signature lives in `method_core`, which keeps the cost of instantiating this
+     * class for each mocked signature down.
      */
-    template <typename TRet, typename... TArgs>
-    class method<TRet(TArgs...)> final
+    template <typename TRet, typename... TArgs, std::size_t Capacity>
+    class method<TRet(TArgs...), Capacity> final : public method_core<Capacity>,
+                                                   private default_result_storage<TRet>
     {
     private:
 
-      static const int INFINITE = -1;
+      using core = method_core<Capacity>;
+      using entry = typename core::entry;
+      using functor = spookshow::internal::inline_function<TRet(TArgs...), Capacity>;
+      using condition = spookshow::internal::inline_function<bool(const std::remove_reference_t<TArgs>&...), Capacity>;
+      using argument_tuple = std::tuple<const std::remove_reference_t<TArgs>&...>;
+
+      // return streams are only created for methods returning values, but their calls must still
+      // compile for other methods
+      using stream_value = std::conditional_t<std::is_void<TRet>::value || std::is_reference<TRet>::value,
+                                              spookshow::internal::noops_token,
+                                              TRet>;
+      using stream_slot = spookshow::internal::stream_slot<stream_value>;
+      using stream = spookshow::internal::inline_function<bool(stream_slot*), Capacity>;
+
+      static const int INFINITE = core::INFINITE;
+
+      // the noops() overloads are templates so that they are only instantiated if they are used,
+      // since they do not compile for methods returning a value
+      template <typename TToken>
+      using noops_only = std::enable_if_t<std::is_same<TToken, spookshow::internal::noops_token>::value>;
+
+      // type of the argument at position Index, used as the key by when()
+      template <std::size_t Index>
+      using key_type = std::decay_t<std::tuple_element_t<Index, std::tuple<TArgs...>>>;
+
+      /**
+       * Table of the functors registered with `when()`, keyed by the argument at `Index`.
+       */
+      template <std::size_t Index>
+      class dispatch_table final : public spookshow::internal::dispatch_table_base
+      {
+      public:
+
+        dispatch_table()
+          : dispatch_table_base(Index)
+        { }
+
+        virtual const void* find(const void* arguments) const override
+        {
+          if (cleared())
+            return nullptr;
+          return functors.find(std::get<Index>(*static_cast<const argument_tuple*>(arguments)));
+        }
+
+        virtual bool commit() override
+        {
+          if (cleared())
+          {
+            functors.clear();
+            reset_cleared();
+          }
+          for (std::pair<key_type<Index>, typename core::stored_function>& registration : pending)
+            functors.insert_or_assign(std::move(registration.first), std::move(registration.second));
+          pending.clear();
+          return !functors.empty();
+        }
+
+        spookshow::internal::flat_hash_map<key_type<Index>, typename core::stored_function> functors;
+
+        // registrations made while a functor of the method was executing
+        spookshow::internal::compact_vector<std::pair<key_type<Index>, typename core::stored_function>> pending;
+
+      protected:
 
-      using functor = std::function<TRet(TArgs...)>;
-      using condition = std::function<bool(TArgs...)>;
+        virtual void discard_pending() override
+        {
+          pending.clear();
+        }
+
+      };
+
+    public:
 
       /**
-       * Class representing an entry in the functor queue.
+       * Handle to an entry in the functor queue.
+       *
+       * `once()`, `repeats()` and `always()` return a reference to a handle stored in the entry
+       * itself, and the handle may also be copied. Entries never move, so either remains valid
+       * until the entry is removed from the queue, no matter how many functors are enqueued after
+       * it.
        */
-      class functor_entry
+      class functor_entry final
       {
       public:
 
         /**
          * Adds a condition which must be true before this method may be called.
          */
-        functor_entry& requires(const condition& condition)
+        functor_entry& requires(condition condition)
         {
-          m_conditions.push_back(condition);
+          m_entry->conditions.emplace_back(std::move(condition));
           return *this;
         }
 
@@ -91,222 +715,626 @@ namespace spookshow
          */
         functor_entry& fulfills(expectation& expectation)
         {
-          m_expectations.push_back(&expectation);
+          m_entry->expectations.emplace_back(&expectation);
           return *this;
         }
 
       private:
 
-        friend class method<TRet(TArgs...)>;
-
-        const functor m_functor;
-        int m_count;
-        std::vector<condition> m_conditions;
-        std::vector<expectation*> m_expectations;
+        friend class method<TRet(TArgs...), Capacity>;
 
-        functor_entry(const functor& functor, int count)
-          : m_functor(functor),
-            m_count(count),
-            m_conditions(),
-            m_expectations()
+        explicit functor_entry(entry& entry)
+          : m_entry(&entry)
         { }
 
-      };
+        entry* m_entry;
 
-    public:
+      };
 
       /**
        * Creates a new mock method object.
        *
-       * @param name
-       * The name of the method.
+       * @param descriptor
+       * The descriptor for the method. This must have static storage duration.
        */
-      explicit method(const std::string& name)
-        : m_name(name)
+      explicit method(const method_descriptor& descriptor)
+        : core(descriptor)
       { }
 
-      /**
-       * Updates the name of the method with a more accurate string.
-       */
-      void set_name(const std::string& name) const
-      {
-        m_name = name;
-      }
-
       /**
        * Invokes the mock method with the specified arguments.
+       *
+       * Parameters declared by value are taken by value, so they may be passed as lvalues. From
+       * here on, the arguments are passed to conditions by `const` reference and then forwarded to
+       * the functor, so no further copies are made.
        */
       TRet invoke(TArgs... args) const
       {
-        if (!m_functor_queue.empty())
-        {
-          functor_entry& entry = m_functor_queue.front();
-
-          // we have to cache the functor in case we delete the entry from the queue
-          functor functor_copy = entry.m_functor;
-
-          // check conditions on this call
-          for (const condition& condition : entry.m_conditions)
-            if (!condition(args...))
-            {
-              std::ostringstream message;
-              message << "Mock method call with unexpected arguments! [" << m_name << "].";
-              spookshow::internal::handle_failure(message.str());
-              return TRet();
-            }
-
-          // fulfill all expectations for this call
-          for (expectation* exp : entry.m_expectations)
-            exp->fulfill();
-
-          // clear the entry from the queue if we're out of available calls
-          if (entry.m_count != INFINITE)
-          {
-            entry.m_count = std::max(entry.m_count - 1, 0);
-            if (entry.m_count == 0)
-              m_functor_queue.pop();
-          }
+        if (this->m_log || this->m_dispatch || this->m_concurrent)
+          return invoke_modes(std::forward<TArgs>(args)...);
 
-          return functor_copy(args...);
-        }
-        else
-        {
-          std::ostringstream message;
-          message << "Unexpected mock method call! [" << m_name << "].";
-          spookshow::internal::handle_failure(message.str());
-          return TRet();
-        }
+        return invoke_queue(std::forward<TArgs>(args)...);
       }
 
       /**
-       * Removes the functor at the front of the queue.
-       *
-       * This can be used (for example) to clear a functor which was enqueued with `repeats()` or
-       * `always()`, but which is no longer needed.
+       * Enqueues a no-op which may be performed once.
        */
-      void skip() const
+      template <typename TToken, typename = noops_only<TToken>>
+      functor_entry& once(const TToken&) const
       {
-        m_functor_queue.pop();
+        return once([] (auto&&...) -> void { });
       }
 
       /**
-       * Clears all functors from the queue.
-       *
-       * This essentially resets the mock method to its initial state.
+       * Enqueues a value which may be returned once.
        */
-      void reset() const
+      template <typename TValue>
+      functor_entry& once(spookshow::internal::returns_token<TValue> token) const
       {
-        std::queue<functor_entry> empty;
-        std::swap(m_functor_queue, empty);
+        // the functor only runs once, so the value is moved out rather than copied
+        check_returns_value();
+        return once([value = token.take()] (auto&&...) mutable -> TValue {
+            return std::move(value);
+          });
       }
 
       /**
-       * Enqueues a no-op which may be performed once.
+       * Enqueues a reference which may be returned once.
        */
-      functor_entry& once(const spookshow::internal::noops_token&) const
+      template <typename TValue>
+      functor_entry& once(const spookshow::internal::returns_ref_token<TValue>& token) const
       {
-        return once([] (TArgs...) -> void { });
+        return repeats(1, token);
       }
 
       /**
-       * Enqueues a value which may be returned once.
+       * Enqueues a sequence of values, each of which may be returned once, in order.
+       *
+       * The values are stored in a single entry, which is executed once for each value, so its
+       * conditions are checked and its expectations are fulfilled on every call.
        */
       template <typename TValue>
-      functor_entry& once(const spookshow::internal::returns_token<TValue>& token) const
+      functor_entry& once(spookshow::internal::returns_each_token<TValue> token) const
       {
-        return once([token] (TArgs...) -> TValue {
-            return token.value();
-          });
+        check_returns_value();
+        const std::size_t count = token.values().size();
+        if (count == 0 || count > static_cast<std::size_t>(std::numeric_limits<int>::max()))
+          spookshow::internal::handle_error("Specified number of values was invalid!");
+
+        return repeats(static_cast<int>(count), spookshow::internal::value_sequence<TValue>(std::move(token.values())));
       }
 
       /**
        * Enqueues a functor which may be performed once.
        */
-      functor_entry& once(const functor& functor) const
+      functor_entry& once(functor functor) const
+      {
+        return make_handle(this->enqueue_functor(std::move(functor), 1));
+      }
+
+      /**
+       * Enqueues a stream from which one value may be returned.
+       */
+      template <typename TStream>
+      functor_entry& once(spookshow::internal::returns_from_token<TStream> token) const
       {
-        return enqueue_functor(functor, 1);
+        return repeats(1, std::move(token));
       }
 
       /**
        * Enqueues a no-op which may be performed a finite number of times.
        */
-      functor_entry& repeats(int count, const spookshow::internal::noops_token&) const
+      template <typename TToken, typename = noops_only<TToken>>
+      functor_entry& repeats(int count, const TToken&) const
       {
-        return repeats(count, [] (TArgs...) -> void { });
+        return repeats(count, [] (auto&&...) -> void { });
       }
 
       /**
        * Enqueues a value which may be returned a finite number of times.
        */
       template <typename TValue>
-      functor_entry& repeats(int count, const spookshow::internal::returns_token<TValue>& token) const
+      functor_entry& repeats(int count, spookshow::internal::returns_token<TValue> token) const
+      {
+        check_returns_value();
+        return repeats(count, spookshow::internal::repeated_value<TValue>(token.take()));
+      }
+
+      /**
+       * Enqueues a reference which may be returned a finite number of times.
+       *
+       * The referenced object is not copied for methods returning references, so it must outlive
+       * the calls.
+       */
+      template <typename TValue>
+      functor_entry& repeats(int count, const spookshow::internal::returns_ref_token<TValue>& token) const
       {
-        return repeats(count, [token] (TArgs...) -> TValue {
-            return token.value();
+        TValue* object = &token.object();
+        return repeats(count, [object] (auto&&...) -> TValue& {
+            return *object;
           });
       }
 
       /**
        * Enqueues a functor which may be performed a finite number of times.
        */
-      functor_entry& repeats(int count, const functor& functor) const
+      functor_entry& repeats(int count, functor functor) const
       {
-        return enqueue_functor(functor, count);
+        return make_handle(this->enqueue_functor(std::move(functor), count));
+      }
+
+      /**
+       * Enqueues a stream from which a finite number of values may be returned.
+       *
+       * Each value is pulled from the stream when the call is made, so memory use does not depend
+       * on the number of values. The entry is removed once `count` values have been returned, or
+       * when the stream ends if it was created with `stream_end::next`. The conditions of the
+       * entry are checked and its expectations fulfilled on every call, and the stream is always
+       * called in place (under the queue lock in concurrent mode).
+       */
+      template <typename TStream>
+      functor_entry& repeats(int count, spookshow::internal::returns_from_token<TStream> token) const
+      {
+        check_returns_value();
+        const spookshow::stream_end end = token.end();
+        return make_handle(this->enqueue_stream(stream(std::move(token.stream())), count, end));
       }
 
       /**
        * Enqueues a no-op which may be performed an infinite number of times.
        */
-      functor_entry& always(const spookshow::internal::noops_token&) const
+      template <typename TToken, typename = noops_only<TToken>>
+      functor_entry& always(const TToken&) const
       {
-        return always([] (TArgs...) -> void { });
+        return always([] (auto&&...) -> void { });
       }
 
       /**
        * Enqueues a value which may be returned an infinite number of times.
        */
       template <typename TValue>
-      functor_entry& always(const spookshow::internal::returns_token<TValue>& token) const
+      functor_entry& always(spookshow::internal::returns_token<TValue> token) const
       {
-        return always([token] (TArgs...) -> TValue {
-            return token.value();
-          });
+        return repeats(INFINITE, std::move(token));
+      }
+
+      /**
+       * Enqueues a reference which may be returned an infinite number of times.
+       */
+      template <typename TValue>
+      functor_entry& always(const spookshow::internal::returns_ref_token<TValue>& token) const
+      {
+        return repeats(INFINITE, token);
       }
 
       /**
        * Enqueues a functor which may be performed an infinite number of times.
        */
-      functor_entry& always(const functor& functor) const
+      functor_entry& always(functor functor) const
+      {
+        return make_handle(this->enqueue_functor(std::move(functor), INFINITE));
+      }
+
+      /**
+       * Enqueues a stream from which values may be returned until it ends.
+       */
+      template <typename TStream>
+      functor_entry& always(spookshow::internal::returns_from_token<TStream> token) const
+      {
+        return repeats(INFINITE, std::move(token));
+      }
+
+      /**
+       * Registers a no-op to be performed whenever the argument at position `Index` equals `key`.
+       */
+      template <std::size_t Index, typename TToken, typename = noops_only<TToken>>
+      void when(const key_type<Index>& key, const TToken&) const
+      {
+        when<Index>(key, [] (auto&&...) -> void { });
+      }
+
+      /**
+       * Registers a value to be returned whenever the argument at position `Index` equals `key`.
+       */
+      template <std::size_t Index, typename TValue>
+      void when(const key_type<Index>& key, spookshow::internal::returns_token<TValue> token) const
+      {
+        check_returns_value();
+        when<Index>(key, spookshow::internal::repeated_value<TValue>(token.take()));
+      }
+
+      /**
+       * Registers a functor to be performed whenever the argument at position `Index` equals `key`.
+       *
+       * Calls are looked up by key in a hash table before the queue is consulted, so any number of
+       * keys may be registered without slowing calls down. Calls whose key has not been registered
+       * fall through to the queue as usual. Keyed functors may be performed any number of times,
+       * and registering a key again replaces its functor. All keys of a method must use the same
+       * argument position, and the argument type must be hashable with `std::hash`.
+       *
+       * Keys registered (and `reset()` calls made) by one of the method's own functors take effect
+       * once the outermost call of the method returns.
+       *
+       * In concurrent mode, keys must be registered before the method is shared between threads.
+       * Keyed functors with a `const` call operator are called without taking a lock, and others
+       * are called one at a time (see `enable_concurrency()`).
+       */
+      template <std::size_t Index>
+      void when(const key_type<Index>& key, functor functor) const
+      {
+        if (!this->m_dispatch)
+          this->m_dispatch.reset(new dispatch_table<Index>());
+        else if (this->m_dispatch->index() != Index)
+          spookshow::internal::handle_error("Keyed functors must all use the same argument position!");
+
+        this->join_registry();
+        dispatch_table<Index>& table = static_cast<dispatch_table<Index>&>(*this->m_dispatch);
+        if (this->m_executing == 0)
+        {
+          table.functors.insert_or_assign(key, std::move(functor));
+          return;
+        }
+
+        // a keyed functor may be running, so the table must not change until the call returns
+        table.pending.emplace_back(key, std::move(functor));
+        this->m_dispatch_deferred = true;
+      }
+
+      /**
+       * Puts this method into spy mode, in which every call is recorded in a call log.
+       *
+       * Functors in the queue are still executed as usual, but a call made while the queue is
+       * empty is not a failure. It just returns a default-constructed value. Like
+       * `enable_concurrency()`, this must be called before the method is shared between threads.
+       *
+       * @param capacity
+       * The maximum number of records in the log. Storage for all of them is allocated up front.
+       *
+       * @param policy
+       * Whether the oldest record is overwritten once the log is full.
+       *
+       * @param sample_interval
+       * Only every `sample_interval`th call is recorded.
+       *
+       * @return
+       * The call log, which remains valid for the lifetime of this method.
+       */
+      spookshow::call_log<TArgs...>& spy(std::size_t capacity,
+                                         spookshow::log_policy policy = spookshow::log_policy::overwrite_oldest,
+                                         std::size_t sample_interval = 1) const
+      {
+        if (this->m_log)
+          spookshow::internal::handle_error("Mock method is already in spy mode!");
+        spookshow::call_log<TArgs...>* log = new spookshow::call_log<TArgs...>(capacity, policy, sample_interval);
+        this->m_log.reset(log);
+        return *log;
+      }
+
+      /**
+       * Returns the call log of this method, which must be in spy mode.
+       */
+      spookshow::call_log<TArgs...>& log() const
       {
-        return enqueue_functor(functor, INFINITE);
+        if (!this->m_log)
+          spookshow::internal::handle_error("Mock method is not in spy mode!");
+        return static_cast<spookshow::call_log<TArgs...>&>(*this->m_log);
       }
 
     private:
 
       /**
-       * Enqueues a new functor.
+       * Constructs the handle to a new entry in the storage the entry reserves for it.
+       */
+      static functor_entry& make_handle(entry& entry)
+      {
+        static_assert(sizeof(functor_entry) <= sizeof(entry.handle) && alignof(functor_entry) <= alignof(decltype(entry.handle)),
+                      "functor_entry must fit in the storage reserved by the queue entry!");
+        static_assert(std::is_trivially_destructible<functor_entry>::value,
+                      "functor_entry must be trivially destructible!");
+        return *new (&entry.handle) functor_entry(entry);
+      }
+
+      /**
+       * Invokes the first functor in the queue.
+       */
+      TRet invoke_queue(TArgs&&... args) const
+      {
+        if (this->m_functor_queue.empty())
+          return unexpected_call(args...);
+
+        entry& entry = this->m_functor_queue.front();
+        if (entry.kind != core::entry_kind::functor)
+          return invoke_special(std::forward<TArgs>(args)...);
+        return invoke_entry(entry, std::forward<TArgs>(args)...);
+      }
+
+      /**
+       * Invokes the first live entry in the queue, when the front of the queue is a stream or has
+       * been retired.
+       */
+      SPOOKSHOW_NOINLINE_ TRet invoke_special(TArgs&&... args) const
+      {
+        entry* live = this->live_front();
+        if (!live)
+          return unexpected_call(args...);
+        if (live->kind == core::entry_kind::stream)
+          return invoke_stream(*live, std::forward<TArgs>(args)...);
+        return invoke_entry(*live, std::forward<TArgs>(args)...);
+      }
+
+      /**
+       * Invokes the functor of the first live entry in the queue.
+       */
+      TRet invoke_entry(entry& entry, TArgs&&... args) const
+      {
+        if (!accept_call(entry, args...))
+          return default_result();
+
+        // if this is the last available call, move the functor out so the entry can be removed
+        if (entry.count != INFINITE && --entry.count == 0)
+        {
+          if (this->m_executing == 0)
+          {
+            typename core::stored_function last_functor = std::move(entry.functor);
+            this->m_functor_queue.pop_front();
+            return functor::call(last_functor, std::forward<TArgs>(args)...);
+          }
+
+          // the functor may already be running further up the stack, so it cannot be moved
+          this->pop_live_front();
+        }
+
+        // otherwise the entry stays in the queue, so call the functor in place
+        typename core::execution_guard guard(*this);
+        return functor::call(entry.functor, std::forward<TArgs>(args)...);
+      }
+
+      /**
+       * Invokes a return stream.
+       */
+      TRet invoke_stream(entry& entry, TArgs&&... args) const
+      {
+        stream_slot slot;
+        if (pull_stream(entry, slot, args...))
+          return take_stream_result(slot);
+
+        // the stream ended and was removed, so the next entry handles the call
+        return invoke_queue(std::forward<TArgs>(args)...);
+      }
+
+      /**
+       * Pulls the next value from a return stream, which must be the first live entry in the queue.
+       * The queue must be locked.
+       *
+       * @return
+       * `false` if the stream has ended and was removed, so the call must be passed on to the next
+       * entry. Otherwise, `slot` holds the result of the call, or is empty if the call failed.
+       */
+      bool pull_stream(entry& entry, stream_slot& slot, const std::remove_reference_t<TArgs>&... args) const
+      {
+        if (!stream::call(entry.functor, nullptr))
+        {
+          // the stream is removed either way, so later calls are handled by the next entry
+          const bool fail = (entry.end == spookshow::stream_end::fail);
+          this->withdraw_front();
+          this->pop_live_front();
+          if (!fail)
+            return false;
+
+          report_failure(spookshow::failure_kind::exhausted_stream, args...);
+          return true;
+        }
+
+        if (!accept_call(entry, args...))
+          return true;
+
+        {
+          typename core::execution_guard guard(*this);
+          stream::call(entry.functor, &slot);
+        }
+
+        if (entry.count != INFINITE && --entry.count == 0)
+          this->pop_live_front();
+        return true;
+      }
+
+      /**
+       * Invokes the mock method in spy mode, with keyed functors, or in concurrent mode.
+       *
+       * This is kept out of line, so that these modes do not slow down ordinary calls.
+       */
+      SPOOKSHOW_NOINLINE_ TRet invoke_modes(TArgs&&... args) const
+      {
+        const argument_tuple arguments(args...);
+        if (this->m_log)
+          this->m_log->record(&arguments);
+
+        const typename core::stored_function* keyed =
+          (this->m_dispatch ? static_cast<const typename core::stored_function*>(this->m_dispatch->find(&arguments)) : nullptr);
+        if (keyed && this->m_concurrent && keyed->const_callable())
+          return functor::call(*keyed, std::forward<TArgs>(args)...);
+        if (keyed)
+        {
+          // keyed functors which are not shareable are called one at a time in concurrent mode
+          spookshow::internal::queue_lock lock = this->lock_queue();
+          typename core::execution_guard guard(*this);
+          return functor::call(*keyed, std::forward<TArgs>(args)...);
+        }
+
+        if (this->m_concurrent)
+          return invoke_concurrent(std::forward<TArgs>(args)...);
+
+        // only spy mode or unmatched keys, so the queue is used as usual
+        return invoke_queue(std::forward<TArgs>(args)...);
+      }
+
+      /**
+       * Invokes the mock method in concurrent mode.
+       */
+      TRet invoke_concurrent(TArgs&&... args) const
+      {
+        // fast path - call the published copy of an always() entry without locking
+        {
+          spookshow::internal::concurrent_state::reader reader(*this->m_concurrent);
+          const entry* published = static_cast<const entry*>(reader.published());
+          if (published)
+          {
+            if (!accept_call(*published, args...))
+              return default_result();
+            return functor::call(published->functor, std::forward<TArgs>(args)...);
+          }
+        }
+
+        spookshow::internal::queue_lock lock = this->lock_queue();
+        entry* live = this->live_front();
+        if (!live)
+        {
+          lock.unlock();
+          return unexpected_call(args...);
+        }
+
+        entry& entry = *live;
+        if (entry.kind == core::entry_kind::stream)
+        {
+          stream_slot slot;
+          if (pull_stream(entry, slot, args...))
+            return take_stream_result(slot);
+
+          lock.unlock();
+          return invoke_concurrent(std::forward<TArgs>(args)...);
+        }
+
+        if (!accept_call(entry, args...))
+          return default_result();
+
+        if (entry.count != INFINITE && --entry.count == 0)
+        {
+          if (this->m_executing == 0)
+          {
+            typename core::stored_function last_functor = std::move(entry.functor);
+            this->m_functor_queue.pop_front();
+            lock.unlock();
+            return functor::call(last_functor, std::forward<TArgs>(args)...);
+          }
+
+          // the functor may already be running further up the stack, so it is called in place
+          this->pop_live_front();
+          typename core::execution_guard guard(*this);
+          return functor::call(entry.functor, std::forward<TArgs>(args)...);
+        }
+
+        // subsequent calls to an always() entry can take the fast path
+        if (entry.count == INFINITE && !this->m_concurrent->published())
+          this->publish_front();
+
+        // run a copy of a shareable functor so other threads are not blocked while it executes
+        if (entry.functor.copyable() && entry.functor.const_callable())
+        {
+          typename core::stored_function functor_copy = entry.functor;
+          lock.unlock();
+          return functor::call(functor_copy, std::forward<TArgs>(args)...);
+        }
+
+        // other functors are called in place, under the lock, so they see every call in order
+        typename core::execution_guard guard(*this);
+        return functor::call(entry.functor, std::forward<TArgs>(args)...);
+      }
+
+      /**
+       * Checks the conditions of an entry and fulfills its expectations.
+       *
+       * @return
+       * `true` if the call is allowed, or `false` if a failure was reported.
+       */
+      bool accept_call(const entry& entry, const std::remove_reference_t<TArgs>&... args) const
+      {
+        // check conditions on this call
+        for (const typename core::stored_function& stored_condition : entry.conditions)
+          if (!condition::call(stored_condition, args...))
+          {
+            report_failure(spookshow::failure_kind::unexpected_arguments, args...);
+            return false;
+          }
+
+        // fulfill all expectations for this call
+        if (!entry.expectations.empty())
+          this->fulfill_expectations(entry.expectations);
+
+        return true;
+      }
+
+      using spookshow::internal::default_result_storage<TRet>::default_result;
+
+      /**
+       * Returns the value pulled from a return stream, or the default result if the call failed.
+       */
+      TRet take_stream_result(stream_slot& slot) const
+      {
+        if (!slot.has_value())
+          return default_result();
+        return spookshow::internal::stream_result<TRet>(slot.value(), std::is_same<stream_value, TRet>());
+      }
+
+      /**
+       * Fails to compile if this method returns a reference.
        *
-       * @param functor
-       * The functor to enqueue.
+       * Values are returned by copy or move, so returning one from a method returning a reference
+       * would leave the caller with a reference to a temporary.
+       */
+      static void check_returns_value()
+      {
+        static_assert(!std::is_reference<TRet>::value, "Use returns_ref() for mock methods returning references!");
+      }
+
+      /**
+       * Handles a call made while the queue was empty.
+       */
+      TRet unexpected_call(const std::remove_reference_t<TArgs>&... args) const
+      {
+        // calls in spy mode are checked after the fact, so they do not need a functor
+        if (!this->m_log)
+          report_failure(spookshow::failure_kind::unexpected_call, args...);
+        return default_result();
+      }
+
+      /**
+       * Reports a failed call to the failure handler.
        *
-       * @param count
-       * The number of times this functor may be executed.
+       * The arguments are captured by reference, and are only formatted if the handler asks for
+       * a message.
        */
-      functor_entry& enqueue_functor(const functor& functor, int count) const
+      void report_failure(spookshow::failure_kind kind, const std::remove_reference_t<TArgs>&... args) const
       {
-        if (count < 1 && count != INFINITE)
-          spookshow::internal::handle_error("Specified functor count was invalid!");
+        const bool has_arguments = (sizeof...(TArgs) != 0);
+        const argument_tuple arguments(args...);
+        this->handle_call_failure(kind,
+                                  (has_arguments ? &arguments : nullptr),
+                                  (has_arguments ? &format_arguments : nullptr));
+      }
 
-        functor_entry entry(functor, count);
-        m_functor_queue.push(entry);
-        return m_functor_queue.back();
+      /**
+       * Writes the arguments captured by `report_failure()` to a stream.
+       */
+      static void format_arguments(std::ostream& stream, const void* arguments)
+      {
+        write_arguments(stream, *static_cast<const argument_tuple*>(arguments), std::index_sequence_for<TArgs...>());
       }
 
-      mutable std::string m_name;
-      mutable std::queue<functor_entry> m_functor_queue;
+      template <std::size_t... Indices>
+      static void write_arguments(std::ostream& stream, const argument_tuple& arguments, std::index_sequence<Indices...>)
+      {
+        using expander = int[];
+        (void) expander { 0, (spookshow::internal::write_argument(stream, std::get<Indices>(arguments), Indices), 0)... };
+      }
 
     };
 
+    // common signatures (with the functor and condition types they use), instantiated in the library
+#define SPOOKSHOW_EXTERN_INSTANTIATION_(tmpl, ...)						\
+    extern template class tmpl<__VA_ARGS__, DEFAULT_INLINE_CAPACITY>;
+    SPOOKSHOW_COMMON_INSTANTIATIONS_(SPOOKSHOW_EXTERN_INSTANTIATION_)
+#undef SPOOKSHOW_EXTERN_INSTANTIATION_
+
   }
 
 }
@@ -326,11 +1354,84 @@ namespace spookshow
 
   /**
    * Creates a token indicating that a method call should return a specific value.
+   *
+   * Rvalues are moved into the token, so move-only values may be returned. `once()` moves the
+   * value out again when the call is made, while `repeats()` and `always()` return a copy of a
+   * single stored value on each call.
    */
   template <typename TValue>
-  inline spookshow::internal::returns_token<TValue> returns(const TValue& value)
+  inline spookshow::internal::returns_token<std::decay_t<TValue>> returns(TValue&& value)
+  {
+      return spookshow::internal::returns_token<std::decay_t<TValue>>(std::forward<TValue>(value));
+  }
+
+  /**
+   * Creates a token indicating that a method call should return a reference to an object.
+   *
+   * This must be used for methods returning references. The object is owned by the caller, and
+   * must outlive the calls which return it. Methods returning values return a copy of the object
+   * as it is at the time of each call.
+   */
+  template <typename TValue>
+  inline spookshow::internal::returns_ref_token<TValue> returns_ref(TValue& object)
+  {
+    return spookshow::internal::returns_ref_token<TValue>(object);
+  }
+
+  /**
+   * Creates a token indicating that successive method calls should return each value in a range.
+   *
+   * This must be passed to `once()`. All values are stored in a single queue entry, so scripting
+   * a long sequence of return values costs a single allocation.
+   */
+  template <typename TRange>
+  inline auto returns_each(const TRange& range)
+    -> spookshow::internal::returns_each_token<std::decay_t<decltype(*std::begin(range))>>
+  {
+    return spookshow::internal::returns_each_token<std::decay_t<decltype(*std::begin(range))>>(std::begin(range), std::end(range));
+  }
+
+  /**
+   * Creates a token indicating that successive method calls should return each listed value.
+   */
+  template <typename TValue>
+  inline spookshow::internal::returns_each_token<TValue> returns_each(std::initializer_list<TValue> values)
+  {
+    return spookshow::internal::returns_each_token<TValue>(values.begin(), values.end());
+  }
+
+  /**
+   * Creates a token indicating that successive method calls should return values produced by a
+   * generator.
+   *
+   * The generator is called with no arguments once for each call, so values are computed on
+   * demand instead of being stored. Pass the token to `repeats()` or `always()`.
+   */
+  template <typename TGenerator>
+  inline spookshow::internal::returns_from_token<spookshow::internal::generator_stream<std::decay_t<TGenerator>>>
+  returns_from(TGenerator&& generator)
+  {
+    using stream = spookshow::internal::generator_stream<std::decay_t<TGenerator>>;
+    return spookshow::internal::returns_from_token<stream>(stream(std::forward<TGenerator>(generator)),
+                                                           spookshow::stream_end::fail);
+  }
+
+  /**
+   * Creates a token indicating that successive method calls should return the values of an
+   * iterator range.
+   *
+   * Only the iterators are stored, and each value is read when its call is made. Pass the token to
+   * `repeats()` or `always()`.
+   *
+   * @param end
+   * How calls are handled once the range runs out of values.
+   */
+  template <typename TIterator>
+  inline spookshow::internal::returns_from_token<spookshow::internal::iterator_stream<TIterator>>
+  returns_from(TIterator first, TIterator last, spookshow::stream_end end = spookshow::stream_end::fail)
   {
-      return spookshow::internal::returns_token<TValue>(value);
+    using stream = spookshow::internal::iterator_stream<TIterator>;
+    return spookshow::internal::returns_from_token<stream>(stream(std::move(first), std::move(last)), end);
   }
 
   /**
@@ -0,0 +1,623 @@
+/**
+ * @file	method_core.hpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2026/10/16
+ */
+
+#pragma once
+
+/* -- Includes -- */
+
+#include <cstddef>
+#include <iosfwd>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include <spookshow/spookshow.hpp>
+#include <spookshow/arena.hpp>
+#include <spookshow/compact_vector.hpp>
+#include <spookshow/concurrency.hpp>
+#include <spookshow/inline_function.hpp>
+#include <spookshow/registry.hpp>
+#include <spookshow/segmented_queue.hpp>
+
+/* -- Types -- */
+
+namespace spookshow
+{
+
+  class expectation;
+
+  /**
+   * Enumeration of the ways in which a mock method can handle a call after its return stream has
+   * run out of values.
+   */
+  enum class stream_end : unsigned char
+  {
+    /** The stream is removed, and the call is reported as a failure. Later calls go to the next entry. */
+    fail,
+
+    /** The stream is removed, and the call is passed on to the next entry in the queue. */
+    next,
+  };
+
+  namespace internal
+  {
+
+    class call_log_base;
+    class method_descriptor;
+
+    /**
+     * Table of functors keyed by the value of one argument, used by `method::when()`.
+     */
+    class dispatch_table_base
+    {
+    public:
+
+      virtual ~dispatch_table_base();
+
+      /** Returns the position of the argument used as the key. */
+      std::size_t index() const
+      {
+        return m_index;
+      }
+
+      /**
+       * Returns the functor registered for a call, or `nullptr` if there is none.
+       *
+       * @param arguments
+       * Pointer to a tuple of `const` references to the arguments of the call.
+       */
+      virtual const void* find(const void* arguments) const = 0;
+
+      /**
+       * Marks the table as cleared while one of its functors may be executing. Lookups find
+       * nothing from now on, but the functors are not destroyed until `commit()` is called.
+       */
+      void defer_clear()
+      {
+        m_cleared = true;
+        discard_pending();
+      }
+
+      /**
+       * Applies the changes deferred while a functor of the method was executing.
+       *
+       * @return
+       * `false` if the table is empty afterwards.
+       */
+      virtual bool commit() = 0;
+
+    protected:
+
+      explicit dispatch_table_base(std::size_t index)
+        : m_index(index),
+          m_cleared(false)
+      { }
+
+      /**
+       * Discards the registrations made since the last call to `commit()`.
+       */
+      virtual void discard_pending() = 0;
+
+      bool cleared() const
+      {
+        return m_cleared;
+      }
+
+      void reset_cleared()
+      {
+        m_cleared = false;
+      }
+
+    private:
+
+      dispatch_table_base(const dispatch_table_base&) = delete;
+      dispatch_table_base& operator =(const dispatch_table_base&) = delete;
+
+      const std::size_t m_index;
+      bool m_cleared;
+
+    };
+
+    /**
+     * Part of `method` which depends on neither the signature nor the inline capacity.
+     *
+     * Everything in this class is compiled into the library, so it is not instantiated by each
+     * translation unit declaring mocks.
+     */
+    class method_base
+    {
+    public:
+
+      /**
+       * Returns the descriptor for this method.
+       */
+      const method_descriptor& descriptor() const
+      {
+        return *m_descriptor;
+      }
+
+      /**
+       * Makes this method safe to use from several threads at once.
+       *
+       * In concurrent mode, `invoke()`, `once()`, `repeats()`, `always()`, `skip()` and `reset()`
+       * may all be called concurrently. Changes to the queue are serialized, but functors are
+       * shared between threads where that cannot change the results of the calls:
+       *
+       * - A functor whose conditions and call operator are all `const` (e.g., a lambda which is not
+       *   `mutable`) is *shareable*. Calls reaching an `always()` entry with a shareable functor do
+       *   not take a lock at all, so they scale with the number of calling threads. Other calls
+       *   copy a shareable functor and run the copy outside of the lock.
+       * - Any other functor (e.g., a `mutable` lambda with a counter) is called in place, under the
+       *   lock, one call at a time. It sees exactly the same calls in the same order as it would
+       *   outside of concurrent mode.
+       *
+       * Since shareable functors may be copied and called from several threads at once, their
+       * `const` call operators must not change any state of their own (such as `mutable` members).
+       * State they share through pointers or references must be synchronized by the test.
+       *
+       * This must be called before the method is shared between threads. Entries returned by
+       * `once()`, `repeats()` and `always()` must be completed with `requires()` and `fulfills()`
+       * before another thread can reach them.
+       */
+      void enable_concurrency() const;
+
+      /**
+       * Returns `true` if this method is in concurrent mode.
+       */
+      bool concurrent() const
+      {
+        return (m_concurrent != nullptr);
+      }
+
+      /**
+       * Returns `true` if this method is in spy mode.
+       */
+      bool spying() const
+      {
+        return (m_log != nullptr);
+      }
+
+    protected:
+
+      static const int INFINITE = -1;
+
+      /**
+       * Functions used by a registry to operate on a method whose inline capacity it does not know.
+       */
+      class registry_operations final
+      {
+      public:
+        void (*reset)(const method_base& method);
+        std::size_t (*unused_functors)(const method_base& method);
+      };
+
+      explicit method_base(const method_descriptor& descriptor);
+      ~method_base();
+
+      /**
+       * Adds this method to the innermost registry on this thread, if there is one.
+       */
+      void join_registry(const registry_operations& operations) const
+      {
+        if (!m_registry && spookshow::mock_registry::s_count.load(std::memory_order_relaxed) != 0)
+          register_method(operations);
+      }
+
+      /**
+       * Removes this method from its registry.
+       */
+      SPOOKSHOW_NOINLINE_ void leave_registry() const;
+
+      /**
+       * Locks the queue if this method is in concurrent mode.
+       */
+      spookshow::internal::queue_lock lock_queue() const;
+
+      /**
+       * Withdraws the published copy of the front entry before it is removed. The queue must be
+       * locked.
+       */
+      void withdraw_front() const;
+
+      /**
+       * Removes all functors registered with `when()`.
+       *
+       * While a functor of this method is executing, the table is only marked as cleared, and is
+       * destroyed once the outermost call returns.
+       */
+      void clear_dispatch() const;
+
+      /**
+       * Applies the changes to the functors registered with `when()` which were deferred while a
+       * functor of this method was executing.
+       */
+      void commit_dispatch() const;
+
+      /**
+       * Fails if `count` is not a valid number of times for a functor to be executed.
+       */
+      static void check_count(int count);
+
+      /**
+       * Fulfills each of the specified expectations.
+       */
+      static void fulfill_expectations(const spookshow::internal::compact_vector<expectation*, spookshow::internal::scripting_allocation>& expectations);
+
+      /**
+       * Reports a failed call of this method to the failure handler.
+       *
+       * @param arguments
+       * Opaque pointer to the arguments of the call, or `nullptr` if there are none.
+       *
+       * @param formatter
+       * Function writing `arguments` to a stream, or `nullptr` if there are no arguments.
+       */
+      void handle_call_failure(spookshow::failure_kind kind,
+                               const void* arguments,
+                               void (*formatter)(std::ostream& stream, const void* arguments)) const;
+
+      const method_descriptor* const m_descriptor;
+      mutable int m_executing { 0 };
+      mutable bool m_dispatch_deferred { false };
+      mutable std::unique_ptr<spookshow::internal::concurrent_state> m_concurrent;
+      mutable std::unique_ptr<spookshow::internal::call_log_base> m_log;
+      mutable std::unique_ptr<spookshow::internal::dispatch_table_base> m_dispatch;
+      mutable spookshow::mock_registry* m_registry { nullptr };
+
+    private:
+
+      method_base(const method_base&) = delete;
+      method_base& operator =(const method_base&) = delete;
+
+      friend class spookshow::mock_registry;
+
+      void register_method(const registry_operations& operations) const;
+
+      // only valid while m_registry is set
+      mutable const registry_operations* m_registry_operations;
+      mutable const method_base* m_registry_previous;
+      mutable const method_base* m_registry_next;
+
+    };
+
+    /**
+     * Signature-independent part of `method`.
+     *
+     * This class owns the functor queue: enqueuing and removing entries, and growing the queue.
+     * Actions and conditions are stored as `inline_function_base` objects, so this class is only
+     * instantiated once for each inline capacity, no matter how many different signatures are
+     * mocked. The default capacity is instantiated in the library.
+     */
+    template <std::size_t Capacity>
+    class method_core : public method_base
+    {
+    protected:
+
+      using stored_function = spookshow::internal::inline_function_base<Capacity>;
+
+      /**
+       * Enumeration of the kinds of entries in the functor queue.
+       */
+      enum class entry_kind : unsigned char
+      {
+        /** The entry holds a functor which handles the call. */
+        functor,
+
+        /** The entry holds a stream from which the result of the call is pulled. */
+        stream,
+
+        /**
+         * The entry was removed while a functor of this method was executing. It is skipped, and
+         * destroyed once the outermost call returns.
+         */
+        retired,
+      };
+
+      /**
+       * Class representing an entry in the functor queue.
+       */
+      class entry final
+      {
+      public:
+
+        entry(stored_function&& entry_functor, int entry_count)
+          : functor(std::move(entry_functor)),
+            count(entry_count),
+            kind(entry_kind::functor),
+            end(spookshow::stream_end::fail),
+            conditions(),
+            expectations()
+        { }
+
+        entry(stored_function&& entry_stream, int entry_count, spookshow::stream_end entry_end)
+          : entry(std::move(entry_stream), entry_count)
+        {
+          kind = entry_kind::stream;
+          end = entry_end;
+        }
+
+        /**
+         * Returns `true` if the functor and all conditions of this entry may be copied, and called
+         * from several threads at once.
+         */
+        bool shareable() const
+        {
+          if (!functor.copyable() || !functor.const_callable())
+            return false;
+          for (const stored_function& condition : conditions)
+            if (!condition.copyable() || !condition.const_callable())
+              return false;
+          return true;
+        }
+
+        stored_function functor;
+        int count;
+        entry_kind kind;
+        spookshow::stream_end end;
+        spookshow::internal::compact_vector<stored_function, spookshow::internal::scripting_allocation> conditions;
+        spookshow::internal::compact_vector<expectation*, spookshow::internal::scripting_allocation> expectations;
+
+        /** Storage for the handle to this entry returned by `once()`, `repeats()` and `always()`. */
+        std::aligned_storage_t<sizeof(void*), alignof(void*)> handle;
+
+      };
+
+      /**
+       * Marks a functor as executing in place for the lifetime of the guard.
+       *
+       * Entries removed while a functor is executing are only retired, and changes to the keyed
+       * functors are deferred, so the functor is not destroyed while it runs. Once the outermost
+       * guard is released, retired entries are destroyed and the deferred changes are applied.
+       */
+      class execution_guard final
+      {
+      public:
+
+        explicit execution_guard(const method_core& method)
+          : m_method(method)
+        {
+          ++m_method.m_executing;
+        }
+
+        ~execution_guard()
+        {
+          if (--m_method.m_executing == 0 && (m_method.m_retired != 0 || m_method.m_dispatch_deferred))
+            m_method.finish_execution();
+        }
+
+      private:
+
+        execution_guard(const execution_guard&) = delete;
+        execution_guard& operator =(const execution_guard&) = delete;
+
+        const method_core& m_method;
+
+      };
+
+      explicit method_core(const method_descriptor& descriptor)
+        : method_base(descriptor)
+      { }
+
+    public:
+
+      /**
+       * Removes the functor at the front of the queue.
+       *
+       * This can be used (for example) to clear a functor which was enqueued with `repeats()` or
+       * `always()`, but which is no longer needed. It may be called by one of the method's own
+       * functors, including the one being skipped.
+       */
+      void skip() const
+      {
+        spookshow::internal::queue_lock lock = lock_queue();
+        if (!live_front())
+          spookshow::internal::handle_error("Attempted to skip a functor in an empty queue!");
+        withdraw_front();
+        pop_live_front();
+      }
+
+      /**
+       * Clears all functors from the queue, along with any functors registered with `when()`.
+       *
+       * This essentially resets the mock method to its initial state. Storage reserved by the queue
+       * is retained. If one of the method's own functors calls this, the queue entries are only
+       * destroyed once the call returns.
+       */
+      void reset() const
+      {
+        spookshow::internal::queue_lock lock = lock_queue();
+        withdraw_front();
+        if (m_executing == 0)
+          m_functor_queue.clear();
+        else
+        {
+          for (entry& entry : m_functor_queue)
+            entry.kind = entry_kind::retired;
+          m_retired = m_functor_queue.size();
+        }
+        clear_dispatch();
+        if (m_registry)
+          leave_registry();
+      }
+
+      /**
+       * Reserves space in the queue for at least `count` functors, so enqueuing them does not
+       * allocate.
+       *
+       * Entries never move once they have been enqueued, so this is only an optimization. Entries
+       * returned by `once()`, `repeats()` and `always()` remain valid until they are removed from
+       * the queue.
+       */
+      void reserve(std::size_t count) const
+      {
+        spookshow::internal::queue_lock lock = lock_queue();
+        m_functor_queue.reserve(count);
+      }
+
+    protected:
+
+      /**
+       * Notes that this method has been scripted, adding it to the current registry if it has not
+       * joined one yet.
+       */
+      void join_registry() const
+      {
+        method_base::join_registry(REGISTRY_OPERATIONS);
+      }
+
+      /**
+       * Enqueues a new functor.
+       *
+       * @param functor
+       * The functor to enqueue.
+       *
+       * @param count
+       * The number of times this functor may be executed.
+       */
+      entry& enqueue_functor(stored_function&& functor, int count) const
+      {
+        check_count(count);
+
+        spookshow::internal::queue_lock lock = lock_queue();
+        join_registry();
+        return m_functor_queue.emplace_back(std::move(functor), count);
+      }
+
+      /**
+       * Enqueues a new return stream.
+       *
+       * @param stream
+       * The stream function, which is called with a pointer to store the next value in, or with
+       * `nullptr` to ask whether there are any values left.
+       *
+       * @param count
+       * The number of values which may be taken from the stream.
+       *
+       * @param end
+       * How calls are handled once the stream runs out of values.
+       */
+      entry& enqueue_stream(stored_function&& stream, int count, spookshow::stream_end end) const
+      {
+        check_count(count);
+
+        spookshow::internal::queue_lock lock = lock_queue();
+        join_registry();
+        return m_functor_queue.emplace_back(std::move(stream), count, end);
+      }
+
+      /**
+       * Returns the first entry in the queue which has not been retired, or `nullptr` if there is
+       * none. The queue must be locked.
+       */
+      entry* live_front() const
+      {
+        if (m_retired == 0)
+          return (m_functor_queue.empty() ? nullptr : &m_functor_queue.front());
+        if (m_retired == m_functor_queue.size())
+          return nullptr;
+
+        // retired entries are always at the front of the queue
+        typename spookshow::internal::segmented_queue<entry>::iterator live = m_functor_queue.begin();
+        for (std::size_t position = 0; position < m_retired; position++)
+          ++live;
+        return &*live;
+      }
+
+      /**
+       * Removes the entry returned by `live_front()`. The queue must be locked.
+       *
+       * While a functor of this method is executing, the entry is retired instead, since it may be
+       * the one which is executing.
+       */
+      void pop_live_front() const
+      {
+        if (m_executing == 0)
+        {
+          m_functor_queue.pop_front();
+          return;
+        }
+
+        live_front()->kind = entry_kind::retired;
+        ++m_retired;
+      }
+
+      /**
+       * Publishes a copy of the live entry at the front of the queue, if it can be shared between
+       * threads. The queue must be locked.
+       */
+      void publish_front() const
+      {
+        // streams are stateful, so every call has to go through the queue
+        const entry& front = *live_front();
+        if (front.kind != entry_kind::functor || !front.shareable())
+          return;
+
+        entry* copy = new entry(stored_function(front.functor), front.count);
+        for (const stored_function& condition : front.conditions)
+          copy->conditions.emplace_back(condition);
+        for (expectation* exp : front.expectations)
+          copy->expectations.emplace_back(exp);
+
+        m_concurrent->publish(copy, [] (const void* published) {
+            delete static_cast<const entry*>(published);
+          });
+      }
+
+      mutable spookshow::internal::segmented_queue<entry> m_functor_queue;
+      mutable std::size_t m_retired { 0 };
+
+    private:
+
+      static const registry_operations REGISTRY_OPERATIONS;
+
+      /**
+       * Destroys the retired entries at the front of the queue, and applies deferred changes to
+       * the keyed functors.
+       */
+      SPOOKSHOW_NOINLINE_ void finish_execution() const
+      {
+        for (; m_retired != 0; m_retired--)
+          m_functor_queue.pop_front();
+        if (m_dispatch_deferred)
+          commit_dispatch();
+      }
+
+      static void reset_method(const method_base& method)
+      {
+        static_cast<const method_core&>(method).reset();
+      }
+
+      static std::size_t unused_functors(const method_base& method)
+      {
+        const method_core& core = static_cast<const method_core&>(method);
+        spookshow::internal::queue_lock lock = core.lock_queue();
+
+        std::size_t unused = 0;
+        for (const entry& entry : core.m_functor_queue)
+          if (entry.kind != entry_kind::retired && entry.count != INFINITE)
+            ++unused;
+        return unused;
+      }
+
+    };
+
+    template <std::size_t Capacity>
+    const method_base::registry_operations method_core<Capacity>::REGISTRY_OPERATIONS
+    {
+      &method_core<Capacity>::reset_method,
+      &method_core<Capacity>::unused_functors,
+    };
+
+    // instantiated in the library
+    extern template class inline_function_base<DEFAULT_INLINE_CAPACITY>;
+    extern template class method_core<DEFAULT_INLINE_CAPACITY>;
+    extern template class compact_vector<inline_function_base<DEFAULT_INLINE_CAPACITY>, scripting_allocation>;
+    extern template class compact_vector<expectation*, scripting_allocation>;
+    extern template class segmented_queue<method_core<DEFAULT_INLINE_CAPACITY>::entry>;
+
+  }
+
+}
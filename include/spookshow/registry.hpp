@@ -0,0 +1,90 @@
+/**
+ * @file	registry.hpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2026/10/17
+ */
+
+#pragma once
+
+/* -- Includes -- */
+
+#include <atomic>
+#include <cstddef>
+
+/* -- Types -- */
+
+namespace spookshow
+{
+
+  namespace internal
+  {
+    class method_base;
+  }
+
+  /**
+   * Scope tracking the mock methods scripted on this thread, so they can be reset or verified
+   * together.
+   *
+   * A mock method joins the innermost registry on the current thread the first time a functor is
+   * enqueued for it (with `once()`, `repeats()`, `always()` or `when()`), and leaves it when it is
+   * reset or destroyed. Methods are linked into the registry intrusively, so joining it allocates
+   * nothing, and `reset_all()` and `verify_all()` only visit the methods which have actually been
+   * scripted, no matter how many mocks have been declared.
+   *
+   * Registries are scoped like expectation orders: each thread has its own stack of registries,
+   * and only the innermost one is joined. Registered methods may be invoked from any thread, but
+   * they must be scripted, reset and destroyed on the thread which owns the registry.
+   */
+  class mock_registry final
+  {
+  public:
+
+    mock_registry();
+    ~mock_registry();
+
+  private:
+
+    mock_registry(const mock_registry&) = delete;
+    mock_registry& operator =(const mock_registry&) = delete;
+
+  public:
+
+    /**
+     * Returns the number of mock methods currently in this registry.
+     */
+    std::size_t size() const
+    {
+      return m_size;
+    }
+
+    /**
+     * Resets every mock method in this registry, as if `reset()` had been called for each of them.
+     * The registry is empty afterwards.
+     */
+    void reset_all();
+
+    /**
+     * Verifies that no mock method in this registry has `once()` or `repeats()` functors which
+     * have not been used up. A failure is reported for each method which does.
+     *
+     * @return
+     * `true` if every method was satisfied.
+     */
+    bool verify_all() const;
+
+  private:
+
+    friend class spookshow::internal::method_base;
+
+    /** The number of registries on all threads, so unscripted methods can skip the lookup. */
+    static std::atomic<std::size_t> s_count;
+
+    mock_registry* const m_previous;
+    const spookshow::internal::method_base* m_head;
+    std::size_t m_size;
+
+    static mock_registry* current_registry();
+
+  };
+
+}
@@ -0,0 +1,195 @@
+/**
+ * @file	ring_buffer.hpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2026/10/16
+ */
+
+#pragma once
+
+/* -- Includes -- */
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/* -- Types -- */
+
+namespace spookshow
+{
+
+  namespace internal
+  {
+
+    /**
+     * Contiguous, growable FIFO queue.
+     *
+     * Elements are stored densely in a single power-of-two sized block, which is not allocated
+     * until the first element is pushed (or `reserve()` is called). References to elements remain
+     * valid until they are popped, or until a push causes the buffer to grow.
+     */
+    template <typename T>
+    class ring_buffer final
+    {
+    private:
+
+      static const std::size_t MINIMUM_CAPACITY = 8;
+
+    public:
+
+      ring_buffer()
+        : m_storage(nullptr),
+          m_capacity(0),
+          m_head(0),
+          m_size(0)
+      { }
+
+      ~ring_buffer()
+      {
+        clear();
+        std::free(m_storage);
+      }
+
+    private:
+
+      ring_buffer(const ring_buffer&) = delete;
+      ring_buffer& operator =(const ring_buffer&) = delete;
+
+    public:
+
+      /** Returns `true` if the queue is empty. */
+      bool empty() const
+      {
+        return (m_size == 0);
+      }
+
+      /** Returns the number of elements in the queue. */
+      std::size_t size() const
+      {
+        return m_size;
+      }
+
+      /** Returns the number of elements the queue can hold without growing. */
+      std::size_t capacity() const
+      {
+        return m_capacity;
+      }
+
+      /** Returns `true` if pushing another element would cause the queue to grow. */
+      bool full() const
+      {
+        return (m_size == m_capacity);
+      }
+
+      /** Returns the element at the front of the queue. */
+      T& front()
+      {
+        return m_storage[m_head];
+      }
+
+      /** Returns the element at the back of the queue. */
+      T& back()
+      {
+        return m_storage[index(m_size - 1)];
+      }
+
+      /** Returns the element at the specified position, counting from the front of the queue. */
+      T& operator [](std::size_t position)
+      {
+        return m_storage[index(position)];
+      }
+
+      /** Returns the element at the specified position, counting from the front of the queue. */
+      const T& operator [](std::size_t position) const
+      {
+        return m_storage[index(position)];
+      }
+
+      /**
+       * Ensures that the queue can hold at least `capacity` elements without growing.
+       */
+      void reserve(std::size_t capacity)
+      {
+        if (capacity <= m_capacity)
+          return;
+
+        std::size_t new_capacity = (m_capacity == 0 ? MINIMUM_CAPACITY : m_capacity);
+        while (new_capacity < capacity)
+          new_capacity *= 2;
+        reallocate(new_capacity);
+      }
+
+      /**
+       * Constructs a new element at the back of the queue.
+       */
+      template <typename... TArgs>
+      T& emplace_back(TArgs&&... args)
+      {
+        if (full())
+          reserve(m_capacity + 1);
+
+        T* element = new (m_storage + index(m_size)) T(std::forward<TArgs>(args)...);
+        ++m_size;
+        return *element;
+      }
+
+      /**
+       * Removes the element at the front of the queue.
+       */
+      void pop_front()
+      {
+        m_storage[m_head].~T();
+        m_head = index(1);
+        --m_size;
+      }
+
+      /**
+       * Removes all elements from the queue. The storage is retained for reuse.
+       */
+      void clear()
+      {
+        while (!empty())
+          pop_front();
+        m_head = 0;
+      }
+
+    private:
+
+      std::size_t index(std::size_t position) const
+      {
+        return ((m_head + position) & (m_capacity - 1));
+      }
+
+      void reallocate(std::size_t new_capacity)
+      {
+        static_assert(std::is_nothrow_move_constructible<T>::value,
+                      "ring_buffer elements must be nothrow move constructible!");
+
+        T* new_storage = static_cast<T*>(std::malloc(new_capacity * sizeof(T)));
+        if (!new_storage)
+          throw std::bad_alloc();
+
+        for (std::size_t position = 0; position < m_size; position++)
+        {
+          T& element = m_storage[index(position)];
+          new (new_storage + position) T(std::move(element));
+          element.~T();
+        }
+
+        std::free(m_storage);
+        m_storage = new_storage;
+        m_capacity = new_capacity;
+        m_head = 0;
+      }
+
+      T* m_storage;
+      std::size_t m_capacity;
+      std::size_t m_head;
+      std::size_t m_size;
+
+    };
+
+  }
+
+}
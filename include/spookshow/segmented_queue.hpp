@@ -0,0 +1,289 @@
+/**
+ * @file	segmented_queue.hpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2026/10/17
+ */
+
+#pragma once
+
+/* -- Includes -- */
+
+#include <cstddef>
+#include <new>
+#include <utility>
+
+/* -- Types -- */
+
+namespace spookshow
+{
+
+  namespace internal
+  {
+
+    /**
+     * Growable FIFO queue whose elements never move.
+     *
+     * Elements are stored in a chain of blocks, each twice the size of the one before it (up to a
+     * limit). Growing the queue links a new block onto the end of the chain instead of moving the
+     * existing elements, so references to elements remain valid until the elements are popped.
+     * Blocks emptied at the front of the queue are kept for reuse, so a queue which is repeatedly
+     * filled and drained stops allocating once it has reached its largest size.
+     */
+    template <typename T>
+    class segmented_queue final
+    {
+    private:
+
+      static const std::size_t MINIMUM_BLOCK_SIZE = 8;
+      static const std::size_t MAXIMUM_BLOCK_SIZE = 4096;
+
+      /**
+       * Header of a block of storage, which is followed by the storage for its elements.
+       */
+      class block final
+      {
+      public:
+        block* next;
+        std::size_t capacity;
+      };
+
+      // offset of the elements from the start of a block
+      static const std::size_t HEADER_SIZE = ((sizeof(block) + alignof(T) - 1) / alignof(T)) * alignof(T);
+
+      static_assert(alignof(T) <= alignof(std::max_align_t), "segmented_queue elements must not be over-aligned!");
+
+    public:
+
+      /**
+       * Forward iterator over the elements of the queue, from front to back.
+       */
+      class iterator final
+      {
+      public:
+
+        T& operator *() const
+        {
+          return elements(m_block)[m_index];
+        }
+
+        T* operator ->() const
+        {
+          return elements(m_block) + m_index;
+        }
+
+        iterator& operator ++()
+        {
+          if (++m_index == m_block->capacity)
+          {
+            m_block = m_block->next;
+            m_index = 0;
+          }
+          return *this;
+        }
+
+        bool operator ==(const iterator& other) const
+        {
+          return (m_block == other.m_block && m_index == other.m_index);
+        }
+
+        bool operator !=(const iterator& other) const
+        {
+          return !(*this == other);
+        }
+
+      private:
+
+        friend class segmented_queue;
+
+        iterator(block* block, std::size_t index)
+          : m_block(block),
+            m_index(index)
+        { }
+
+        block* m_block;
+        std::size_t m_index;
+
+      };
+
+      segmented_queue()
+        : m_head_block(nullptr),
+          m_tail_block(nullptr),
+          m_spare_blocks(nullptr),
+          m_head(0),
+          m_tail(0),
+          m_size(0)
+      { }
+
+      ~segmented_queue()
+      {
+        clear();
+        free_blocks(m_head_block);
+        free_blocks(m_spare_blocks);
+      }
+
+    private:
+
+      segmented_queue(const segmented_queue&) = delete;
+      segmented_queue& operator =(const segmented_queue&) = delete;
+
+    public:
+
+      /** Returns `true` if the queue is empty. */
+      bool empty() const
+      {
+        return (m_size == 0);
+      }
+
+      /** Returns the number of elements in the queue. */
+      std::size_t size() const
+      {
+        return m_size;
+      }
+
+      /** Returns the element at the front of the queue. */
+      T& front()
+      {
+        return elements(m_head_block)[m_head];
+      }
+
+      /** Returns the element at the front of the queue. */
+      const T& front() const
+      {
+        return elements(m_head_block)[m_head];
+      }
+
+      /** Returns an iterator to the element at the front of the queue. */
+      iterator begin() const
+      {
+        return (empty() ? end() : iterator(m_head_block, m_head));
+      }
+
+      /** Returns an iterator past the element at the back of the queue. */
+      iterator end() const
+      {
+        // a full tail block has no next block, so incrementing past its last element gives this
+        if (!m_tail_block || m_tail == m_tail_block->capacity)
+          return iterator(nullptr, 0);
+        return iterator(m_tail_block, m_tail);
+      }
+
+      /**
+       * Ensures that at least `count` elements can be in the queue at once without allocating.
+       */
+      void reserve(std::size_t count)
+      {
+        std::size_t available = m_size + (m_tail_block ? m_tail_block->capacity - m_tail : 0);
+        for (const block* spare = m_spare_blocks; spare; spare = spare->next)
+          available += spare->capacity;
+        if (count <= available)
+          return;
+
+        block* spare = allocate_block(count - available < MINIMUM_BLOCK_SIZE ? MINIMUM_BLOCK_SIZE : count - available);
+        spare->next = m_spare_blocks;
+        m_spare_blocks = spare;
+      }
+
+      /**
+       * Constructs a new element at the back of the queue.
+       */
+      template <typename... TArgs>
+      T& emplace_back(TArgs&&... args)
+      {
+        if (!m_tail_block || m_tail == m_tail_block->capacity)
+          append_block();
+
+        T* element = new (elements(m_tail_block) + m_tail) T(std::forward<TArgs>(args)...);
+        ++m_tail;
+        ++m_size;
+        return *element;
+      }
+
+      /**
+       * Removes the element at the front of the queue.
+       */
+      void pop_front()
+      {
+        elements(m_head_block)[m_head].~T();
+        --m_size;
+
+        if (m_size == 0)
+        {
+          // the head and tail are in the same block, which can be reused from the start
+          m_head = 0;
+          m_tail = 0;
+        }
+        else if (++m_head == m_head_block->capacity)
+        {
+          block* emptied = m_head_block;
+          m_head_block = emptied->next;
+          m_head = 0;
+          emptied->next = m_spare_blocks;
+          m_spare_blocks = emptied;
+        }
+      }
+
+      /**
+       * Removes all elements from the queue. The storage is retained for reuse.
+       */
+      void clear()
+      {
+        while (!empty())
+          pop_front();
+      }
+
+    private:
+
+      static T* elements(block* block)
+      {
+        return reinterpret_cast<T*>(reinterpret_cast<char*>(block) + HEADER_SIZE);
+      }
+
+      static block* allocate_block(std::size_t capacity)
+      {
+        block* new_block = static_cast<block*>(::operator new(HEADER_SIZE + capacity * sizeof(T)));
+        new_block->next = nullptr;
+        new_block->capacity = capacity;
+        return new_block;
+      }
+
+      static void free_blocks(block* first)
+      {
+        while (first)
+        {
+          block* next = first->next;
+          ::operator delete(first);
+          first = next;
+        }
+      }
+
+      void append_block()
+      {
+        block* new_block = m_spare_blocks;
+        if (new_block)
+          m_spare_blocks = new_block->next;
+        else if (!m_tail_block)
+          new_block = allocate_block(MINIMUM_BLOCK_SIZE);
+        else
+          new_block = allocate_block(m_tail_block->capacity < MAXIMUM_BLOCK_SIZE ? m_tail_block->capacity * 2 : MAXIMUM_BLOCK_SIZE);
+        new_block->next = nullptr;
+
+        if (m_tail_block)
+          m_tail_block->next = new_block;
+        else
+          m_head_block = new_block;
+        m_tail_block = new_block;
+        m_tail = 0;
+      }
+
+      block* m_head_block;
+      block* m_tail_block;
+      block* m_spare_blocks;
+      std::size_t m_head;
+      std::size_t m_tail;
+      std::size_t m_size;
+
+    };
+
+  }
+
+}
@@ -10,15 +10,30 @@
 /* -- Includes -- */
 
 #include <functional>
+#include <string>
+
+/* -- Macros -- */
+
+// keeps rarely taken paths from being inlined into the mock method call path
+#if defined(__GNUC__)
+#define SPOOKSHOW_NOINLINE_ __attribute__((noinline))
+#else
+#define SPOOKSHOW_NOINLINE_
+#endif
 
 /* -- Types -- */
 
 namespace spookshow
 {
 
+  class failure;
+
   /** Typedef for functions which report a test failure. */
   typedef std::function<void(const std::string&)> fail_handler;
 
+  /** Typedef for functions which report a structured test failure record. */
+  typedef std::function<void(const failure&)> failure_handler;
+
 }
 
 /* -- Procedure Prototypes -- */
@@ -28,16 +43,27 @@ namespace spookshow
 
   /**
    * Sets the failure handler used by the Spookshow library.
+   *
+   * The handler receives a formatted message. This replaces any handler set with
+   * `set_failure_handler()`.
    */
   void set_fail_handler(fail_handler handler);
 
+  /**
+   * Sets a failure handler receiving structured failure records.
+   *
+   * No message is formatted unless the handler calls `failure::message()`. This replaces any
+   * handler set with `set_fail_handler()`.
+   */
+  void set_failure_handler(failure_handler handler);
+
   namespace internal
   {
 
     /**
      * Reports a test failure to the failure handler.
      */
-    void handle_failure(const std::string& message);
+    void handle_failure(const failure& failure);
 
     /**
      * Handles an unrecoverable test logic error. This method does not return.
@@ -50,8 +76,20 @@ namespace spookshow
 
 /* -- Library Includes -- */
 
+#include <spookshow/arena.hpp>
+#include <spookshow/call_log.hpp>
+#include <spookshow/compact_vector.hpp>
+#include <spookshow/concurrency.hpp>
 #include <spookshow/condition.hpp>
 #include <spookshow/expectation.hpp>
 #include <spookshow/expectation_order.hpp>
+#include <spookshow/failure.hpp>
+#include <spookshow/flat_hash_map.hpp>
+#include <spookshow/inline_function.hpp>
 #include <spookshow/macros.hpp>
 #include <spookshow/method.hpp>
+#include <spookshow/method_core.hpp>
+#include <spookshow/registry.hpp>
+#include <spookshow/ring_buffer.hpp>
+#include <spookshow/segmented_queue.hpp>
+#include <spookshow/trace.hpp>
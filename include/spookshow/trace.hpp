@@ -0,0 +1,610 @@
+/**
+ * @file	trace.hpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2026/10/16
+ */
+
+#pragma once
+
+/* -- Includes -- */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <spookshow/spookshow.hpp>
+#include <spookshow/compact_vector.hpp>
+#include <spookshow/method.hpp>
+
+/* -- Types -- */
+
+namespace spookshow
+{
+
+  namespace internal
+  {
+
+    /**
+     * Buffer into which the fields of a trace record are encoded.
+     */
+    class trace_buffer final
+    {
+    public:
+
+      /** Writes a single byte. */
+      void write_byte(unsigned char byte)
+      {
+        m_bytes.emplace_back(byte);
+      }
+
+      /** Writes an unsigned integer in LEB128 format (seven bits per byte, low bits first). */
+      void write_varint(std::uint64_t value)
+      {
+        while (value >= 0x80)
+        {
+          write_byte(static_cast<unsigned char>(value | 0x80));
+          value >>= 7;
+        }
+        write_byte(static_cast<unsigned char>(value));
+      }
+
+      /** Writes a block of raw bytes. */
+      void write_bytes(const void* data, std::size_t size)
+      {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (std::size_t idx = 0; idx < size; idx++)
+          write_byte(bytes[idx]);
+      }
+
+      /** Returns the encoded bytes. */
+      const unsigned char* data() const
+      {
+        return m_bytes.begin();
+      }
+
+      /** Returns the number of encoded bytes. */
+      std::size_t size() const
+      {
+        return m_bytes.size();
+      }
+
+      /** Removes all bytes from the buffer. Its storage is retained. */
+      void clear()
+      {
+        m_bytes.clear();
+      }
+
+    private:
+      spookshow::internal::compact_vector<unsigned char> m_bytes;
+    };
+
+    /**
+     * Reports a trace which cannot be decoded. This method does not return.
+     */
+    [[noreturn]] void trace_corrupt();
+
+    /**
+     * Cursor decoding values from a range of a trace.
+     */
+    class trace_cursor final
+    {
+    public:
+
+      trace_cursor(const unsigned char* begin, const unsigned char* end)
+        : m_position(begin),
+          m_end(end)
+      { }
+
+      /** Returns `true` if every byte has been read. */
+      bool at_end() const
+      {
+        return (m_position == m_end);
+      }
+
+      /** Reads a single byte. */
+      unsigned char read_byte()
+      {
+        if (m_position == m_end)
+          trace_corrupt();
+        return *m_position++;
+      }
+
+      /** Reads an unsigned integer written by `trace_buffer::write_varint()`. */
+      std::uint64_t read_varint()
+      {
+        std::uint64_t value = 0;
+        for (unsigned int shift = 0; shift < 64; shift += 7)
+        {
+          const unsigned char byte = read_byte();
+          value |= (static_cast<std::uint64_t>(byte & 0x7F) << shift);
+          if ((byte & 0x80) == 0)
+            return value;
+        }
+        trace_corrupt();
+      }
+
+      /** Skips a block of raw bytes, and returns a pointer to the first of them. */
+      const unsigned char* read_bytes(std::size_t size)
+      {
+        if (size > static_cast<std::size_t>(m_end - m_position))
+          trace_corrupt();
+        const unsigned char* bytes = m_position;
+        m_position += size;
+        return bytes;
+      }
+
+    private:
+      const unsigned char* m_position;
+      const unsigned char* m_end;
+    };
+
+    /**
+     * Maps a signed difference onto an unsigned integer, so that small differences of either sign
+     * are encoded in few bytes.
+     */
+    inline std::uint64_t zigzag_encode(std::uint64_t difference)
+    {
+      return ((difference << 1) ^ (0 - (difference >> 63)));
+    }
+
+    inline std::uint64_t zigzag_decode(std::uint64_t value)
+    {
+      return ((value >> 1) ^ (0 - (value & 1)));
+    }
+
+    /**
+     * Class encoding values of type `T` in a trace.
+     *
+     * Each field of a record (each argument, and the return value) has a column, holding state
+     * carried over from the previous record of the same method. Specializations must provide:
+     *
+     * - `static void encode(trace_buffer& buffer, std::uint64_t& column, const T& value)`
+     * - `static T decode(trace_cursor& cursor, std::uint64_t& column)`
+     *
+     * Integers, enumerations, `bool`, `float`, `double` and `std::string` are supported.
+     */
+    template <typename T, typename = void>
+    class trace_codec;
+
+    /**
+     * Integers and enumerations are written as the zigzag-encoded difference from the previous
+     * value in their column.
+     */
+    template <typename T>
+    class trace_codec<T, std::enable_if_t<std::is_integral<T>::value || std::is_enum<T>::value>> final
+    {
+    public:
+
+      static void encode(trace_buffer& buffer, std::uint64_t& column, const T& value)
+      {
+        const std::uint64_t bits = static_cast<std::uint64_t>(static_cast<integer>(value));
+        buffer.write_varint(zigzag_encode(bits - column));
+        column = bits;
+      }
+
+      static T decode(trace_cursor& cursor, std::uint64_t& column)
+      {
+        column += zigzag_decode(cursor.read_varint());
+        return static_cast<T>(static_cast<integer>(column));
+      }
+
+    private:
+
+      using integer = typename std::conditional_t<std::is_enum<T>::value,
+                                                  std::underlying_type<T>,
+                                                  std::enable_if<true, T>>::type;
+
+    };
+
+    /**
+     * Floating point values are written as the exclusive or of their bits with the previous value
+     * in their column. Only the bytes between the leading and trailing zero bytes of the result are
+     * written, after a byte holding the number of each, so repeated values take one byte and
+     * nearby values (whose sign, exponent and high mantissa bits match) take a few. No value takes
+     * more than nine bytes.
+     */
+    template <typename T>
+    class trace_codec<T, std::enable_if_t<std::is_same<T, float>::value || std::is_same<T, double>::value>> final
+    {
+    public:
+
+      static void encode(trace_buffer& buffer, std::uint64_t& column, const T& value)
+      {
+        const double widened = value;
+        std::uint64_t bits;
+        std::memcpy(&bits, &widened, sizeof(bits));
+        std::uint64_t difference = bits ^ column;
+        column = bits;
+
+        if (difference == 0)
+        {
+          buffer.write_byte(8 << 4);
+          return;
+        }
+
+        unsigned int leading = 0;
+        while ((difference >> (56 - 8 * leading)) == 0)
+          ++leading;
+        unsigned int trailing = 0;
+        while ((difference & 0xFF) == 0)
+        {
+          difference >>= 8;
+          ++trailing;
+        }
+
+        buffer.write_byte(static_cast<unsigned char>((leading << 4) | trailing));
+        for (unsigned int idx = leading + trailing; idx < 8; idx++)
+        {
+          buffer.write_byte(static_cast<unsigned char>(difference));
+          difference >>= 8;
+        }
+      }
+
+      static T decode(trace_cursor& cursor, std::uint64_t& column)
+      {
+        const unsigned char header = cursor.read_byte();
+        const unsigned int leading = (header >> 4);
+        const unsigned int trailing = (header & 0x0F);
+        if (leading + trailing > 8)
+          trace_corrupt();
+
+        std::uint64_t difference = 0;
+        for (unsigned int idx = trailing; idx < 8 - leading; idx++)
+          difference |= (static_cast<std::uint64_t>(cursor.read_byte()) << (8 * idx));
+        column ^= difference;
+
+        double widened;
+        std::memcpy(&widened, &column, sizeof(widened));
+        return static_cast<T>(widened);
+      }
+
+    };
+
+    /**
+     * Strings are written as their length followed by their characters.
+     */
+    template <>
+    class trace_codec<std::string> final
+    {
+    public:
+
+      static void encode(trace_buffer& buffer, std::uint64_t&, const std::string& value)
+      {
+        buffer.write_varint(value.size());
+        buffer.write_bytes(value.data(), value.size());
+      }
+
+      static std::string decode(trace_cursor& cursor, std::uint64_t&)
+      {
+        const std::size_t size = cursor.read_varint();
+        return std::string(reinterpret_cast<const char*>(cursor.read_bytes(size)), size);
+      }
+
+    };
+
+    /**
+     * Base class for the per-method state owned by a `trace_recorder` or `trace_replayer`.
+     */
+    class trace_channel_base
+    {
+    public:
+      virtual ~trace_channel_base();
+    };
+
+    template <typename TSignature, typename TTarget>
+    class record_channel;
+
+    template <typename TSignature>
+    class replay_channel;
+
+  }
+
+  /**
+   * Records the calls made to mock methods which forward to a real object.
+   *
+   * Each recorded method gets an `always()` entry which calls a target (usually the same method of
+   * a real object) and appends the arguments and return value of the call to a binary trace file.
+   * The method is identified by name, which is only written once. Each call is written as a
+   * compact record: integers are delta-encoded against the previous call of the same method, and
+   * all integers are variable-length. The trace can later be played back with `trace_replayer`.
+   *
+   * The recorder must outlive the calls to the recorded methods, and they must not be called
+   * concurrently. The trace is complete once the recorder is destroyed.
+   */
+  class trace_recorder final
+  {
+  public:
+
+    explicit trace_recorder(const std::string& path);
+    ~trace_recorder();
+
+    /**
+     * Records calls to a mock method, which forwards them to `target`.
+     *
+     * @param name
+     * The name identifying the method in the trace.
+     *
+     * @param method
+     * The mock method to record.
+     *
+     * @param target
+     * Callable with the signature of the method, which makes the real call.
+     */
+    template <typename TRet, typename... TArgs, std::size_t Capacity, typename TTarget>
+    void record(const std::string& name,
+                const spookshow::internal::method<TRet(TArgs...), Capacity>& method,
+                TTarget target)
+    {
+      using channel_type = spookshow::internal::record_channel<TRet(TArgs...), TTarget>;
+      channel_type* channel = new channel_type(*this, add_method(name), std::move(target));
+      adopt(channel);
+      method.always([channel] (TArgs&&... args) -> TRet {
+          return channel->call(std::forward<TArgs>(args)...);
+        });
+    }
+
+    /**
+     * Records calls to a mock method, using its signature as its name in the trace.
+     */
+    template <typename TRet, typename... TArgs, std::size_t Capacity, typename TTarget>
+    void record(const spookshow::internal::method<TRet(TArgs...), Capacity>& method, TTarget target)
+    {
+      record(method.descriptor().signature, method, std::move(target));
+    }
+
+    /**
+     * Returns the number of calls recorded so far.
+     */
+    std::uint64_t calls() const
+    {
+      return m_calls;
+    }
+
+    /**
+     * Writes any buffered records to the trace file.
+     */
+    void flush();
+
+  private:
+
+    trace_recorder(const trace_recorder&) = delete;
+    trace_recorder& operator =(const trace_recorder&) = delete;
+
+    template <typename TSignature, typename TTarget>
+    friend class spookshow::internal::record_channel;
+
+    class file;
+
+    const std::unique_ptr<file> m_file;
+    std::uint64_t m_calls;
+
+    std::uint64_t add_method(const std::string& name);
+    void adopt(spookshow::internal::trace_channel_base* channel);
+    void write_record(std::uint64_t id, const spookshow::internal::trace_buffer& payload);
+
+  };
+
+  /**
+   * Plays back a trace written by `trace_recorder` through mock methods.
+   *
+   * The trace file is memory-mapped where the platform allows it (and read into memory where it
+   * does not). It is read in a single pass, as the replayed methods need their next records, and
+   * each record is handed to the method it belongs to. Records which are read before their method
+   * needs them (because other methods were called first) are queued by position, so memory use
+   * only grows when methods are called far out of their recorded order. Each method replays its
+   * own calls in the recorded order, independently of the other methods in the trace.
+   *
+   * Each replayed method gets an `always()` entry which returns the recorded return values. A call
+   * whose arguments differ from the recording, or which is made after all of the recorded calls
+   * of that method have been replayed, is reported as a call with unexpected arguments.
+   *
+   * Every method must be replayed before any replayed call is made. The replayer must outlive the
+   * calls to the replayed methods, and they must not be called concurrently.
+   */
+  class trace_replayer final
+  {
+  public:
+
+    explicit trace_replayer(const std::string& path);
+    ~trace_replayer();
+
+    /**
+     * Replays the calls recorded for `name` through a mock method.
+     */
+    template <typename TRet, typename... TArgs, std::size_t Capacity>
+    void replay(const std::string& name, const spookshow::internal::method<TRet(TArgs...), Capacity>& method)
+    {
+      using channel_type = spookshow::internal::replay_channel<TRet(TArgs...)>;
+      channel_type* channel = new channel_type(*this, add_method(name));
+      adopt(channel);
+      method.always([channel] (TArgs&&...) -> TRet {
+          return channel->take();
+        })
+        .requires([channel] (const std::remove_reference_t<TArgs>&... args) {
+            return channel->matches(args...);
+          });
+    }
+
+    /**
+     * Replays the calls recorded for a mock method, using its signature as its name in the trace.
+     */
+    template <typename TRet, typename... TArgs, std::size_t Capacity>
+    void replay(const spookshow::internal::method<TRet(TArgs...), Capacity>& method)
+    {
+      replay(method.descriptor().signature, method);
+    }
+
+  private:
+
+    trace_replayer(const trace_replayer&) = delete;
+    trace_replayer& operator =(const trace_replayer&) = delete;
+
+    template <typename TSignature>
+    friend class spookshow::internal::replay_channel;
+
+    class mapping;
+
+    const std::unique_ptr<mapping> m_mapping;
+
+    std::size_t add_method(const std::string& name);
+    void adopt(spookshow::internal::trace_channel_base* channel);
+    bool next_record(std::size_t method, spookshow::internal::trace_cursor& fields);
+
+  };
+
+  namespace internal
+  {
+
+    /**
+     * Records the calls of a single method for a `trace_recorder`.
+     */
+    template <typename TRet, typename... TArgs, typename TTarget>
+    class record_channel<TRet(TArgs...), TTarget> final : public trace_channel_base
+    {
+    public:
+
+      static_assert(!std::is_reference<TRet>::value, "Methods returning references cannot be recorded!");
+
+      record_channel(trace_recorder& recorder, std::uint64_t id, TTarget target)
+        : m_recorder(recorder),
+          m_id(id),
+          m_target(std::move(target)),
+          m_columns()
+      { }
+
+      /**
+       * Forwards a call to the target and records it.
+       */
+      TRet call(TArgs&&... args)
+      {
+        // the arguments are encoded first, since the target may move from them
+        m_buffer.clear();
+        encode_arguments(std::index_sequence_for<TArgs...>(), args...);
+        return finish(std::is_void<TRet>(), std::forward<TArgs>(args)...);
+      }
+
+    private:
+
+      template <std::size_t... Indices>
+      void encode_arguments(std::index_sequence<Indices...>, const std::remove_reference_t<TArgs>&... args)
+      {
+        using expander = int[];
+        (void) expander { 0, (trace_codec<std::decay_t<TArgs>>::encode(m_buffer, m_columns[Indices], args), 0)... };
+      }
+
+      void finish(std::true_type, TArgs&&... args)
+      {
+        m_target(std::forward<TArgs>(args)...);
+        m_recorder.write_record(m_id, m_buffer);
+      }
+
+      TRet finish(std::false_type, TArgs&&... args)
+      {
+        TRet result = m_target(std::forward<TArgs>(args)...);
+        trace_codec<std::decay_t<TRet>>::encode(m_buffer, m_columns[sizeof...(TArgs)], result);
+        m_recorder.write_record(m_id, m_buffer);
+        return result;
+      }
+
+      trace_recorder& m_recorder;
+      const std::uint64_t m_id;
+      TTarget m_target;
+      std::uint64_t m_columns[sizeof...(TArgs) + 1];
+      trace_buffer m_buffer;
+
+    };
+
+    /**
+     * Replays the calls of a single method for a `trace_replayer`.
+     */
+    template <typename TRet, typename... TArgs>
+    class replay_channel<TRet(TArgs...)> final : public trace_channel_base
+    {
+    public:
+
+      static_assert(!std::is_reference<TRet>::value, "Methods returning references cannot be replayed!");
+
+      replay_channel(trace_replayer& replayer, std::size_t method)
+        : m_replayer(replayer),
+          m_method(method),
+          m_pending(false),
+          m_columns(),
+          m_arguments(),
+          m_result()
+      { }
+
+      /**
+       * Returns `true` if there is another recorded call, and its arguments match `args`.
+       */
+      bool matches(const std::remove_reference_t<TArgs>&... args)
+      {
+        if (!m_pending && !next())
+          return false;
+        return (m_arguments == std::tie(args...));
+      }
+
+      /**
+       * Returns the result of the recorded call matched by `matches()`.
+       */
+      TRet take()
+      {
+        m_pending = false;
+        return static_cast<TRet>(std::move(m_result));
+      }
+
+    private:
+
+      // placeholder for the result of a method returning void
+      class no_result final { };
+
+      using result_type = std::conditional_t<std::is_void<TRet>::value, no_result, TRet>;
+
+      /**
+       * Decodes the next recorded call of this method.
+       */
+      bool next()
+      {
+        trace_cursor fields(nullptr, nullptr);
+        if (!m_replayer.next_record(m_method, fields))
+          return false;
+
+        decode_arguments(fields, std::index_sequence_for<TArgs...>());
+        decode_result(fields, std::is_void<TRet>());
+        m_pending = true;
+        return true;
+      }
+
+      template <std::size_t... Indices>
+      void decode_arguments(trace_cursor& fields, std::index_sequence<Indices...>)
+      {
+        // the elements of a braced initializer list are evaluated in order
+        m_arguments = std::tuple<std::decay_t<TArgs>...> {
+          trace_codec<std::decay_t<TArgs>>::decode(fields, m_columns[Indices])...
+        };
+      }
+
+      void decode_result(trace_cursor&, std::true_type)
+      { }
+
+      void decode_result(trace_cursor& fields, std::false_type)
+      {
+        m_result = trace_codec<result_type>::decode(fields, m_columns[sizeof...(TArgs)]);
+      }
+
+      trace_replayer& m_replayer;
+      const std::size_t m_method;
+      bool m_pending;
+      std::uint64_t m_columns[sizeof...(TArgs) + 1];
+      std::tuple<std::decay_t<TArgs>...> m_arguments;
+      result_type m_result;
+
+    };
+
+  }
+
+}
@@ -0,0 +1,198 @@
+/**
+ * @file	arena.cpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2026/10/17
+ */
+
+/* -- Includes -- */
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <functional>
+#include <mutex>
+#include <new>
+#include <vector>
+
+#include <spookshow/spookshow.hpp>
+
+/* -- Namespaces -- */
+
+using namespace spookshow;
+
+/* -- Types -- */
+
+namespace
+{
+
+  /**
+   * Rounds a size up to a multiple of the maximum alignment.
+   */
+  std::size_t align_size(std::size_t size)
+  {
+    const std::size_t alignment = alignof(std::max_align_t);
+    return (size + alignment - 1) & ~(alignment - 1);
+  }
+
+}
+
+/**
+ * Header at the start of each chunk owned by an arena.
+ */
+class alignas(std::max_align_t) scripting_arena::chunk final
+{
+public:
+  chunk* next;
+  std::size_t size;
+
+  /** Returns `true` if `storage` was carved from this chunk. */
+  bool contains(const void* storage) const
+  {
+    const unsigned char* begin = reinterpret_cast<const unsigned char*>(this + 1);
+    const unsigned char* address = static_cast<const unsigned char*>(storage);
+    return (!std::less<const unsigned char*>()(address, begin) &&
+            std::less<const unsigned char*>()(address, begin + size));
+  }
+};
+
+/* -- Variables -- */
+
+namespace
+{
+  /** The innermost arena on this thread, or `nullptr` if there is none. */
+  thread_local scripting_arena* s_arena = nullptr;
+
+  /** The number of arenas on all threads, so that heap storage is released without locking. */
+  std::atomic<std::size_t> s_arena_count { 0 };
+
+  /** Guards `s_arenas`, and the chunk lists of the arenas in it. */
+  std::mutex s_arenas_mutex;
+
+  /** The arenas on all threads. */
+  std::vector<scripting_arena*> s_arenas;
+}
+
+/* -- Procedures -- */
+
+scripting_arena::scripting_arena(std::size_t chunk_size)
+  : m_previous(s_arena),
+    m_minimum_chunk_size(std::max(align_size(chunk_size), alignof(std::max_align_t))),
+    m_chunk_size(m_minimum_chunk_size),
+    m_chunks(nullptr),
+    m_next(nullptr),
+    m_end(nullptr),
+    m_allocated(0),
+    m_chunk_count(0),
+    m_live(0)
+{
+  s_arena = this;
+
+  std::lock_guard<std::mutex> lock(s_arenas_mutex);
+  s_arenas.push_back(this);
+  s_arena_count.fetch_add(1, std::memory_order_relaxed);
+}
+
+scripting_arena::~scripting_arena()
+{
+  if (s_arena != this)
+    internal::handle_error("Scripting arena stack was corrupted!");
+  s_arena = m_previous;
+
+  {
+    std::lock_guard<std::mutex> lock(s_arenas_mutex);
+    if (m_live != 0)
+      internal::handle_error("Scripting arena was destroyed while storage carved from it was in use!");
+    s_arenas.erase(std::find(s_arenas.begin(), s_arenas.end(), this));
+    s_arena_count.fetch_sub(1, std::memory_order_relaxed);
+  }
+
+  while (m_chunks)
+  {
+    chunk* next = m_chunks->next;
+    std::free(m_chunks);
+    m_chunks = next;
+  }
+}
+
+void* scripting_arena::allocate(std::size_t size)
+{
+  // every allocation takes at least one byte, so that it lies inside its chunk
+  size = align_size(std::max<std::size_t>(size, 1));
+  m_allocated += size;
+
+  void* storage;
+  if (size > m_chunk_size / 2)
+  {
+    // allocations which would waste most of a chunk get a chunk of their own
+    storage = add_chunk(size) + 1;
+  }
+  else
+  {
+    if (static_cast<std::size_t>(m_end - m_next) < size)
+    {
+      chunk* new_chunk = add_chunk(m_chunk_size);
+      m_next = reinterpret_cast<unsigned char*>(new_chunk + 1);
+      m_end = m_next + m_chunk_size;
+      m_chunk_size = std::min(2 * m_chunk_size, 16 * m_minimum_chunk_size);
+    }
+    storage = m_next;
+    m_next += size;
+  }
+
+  m_live.fetch_add(1, std::memory_order_relaxed);
+  return storage;
+}
+
+scripting_arena::chunk* scripting_arena::add_chunk(std::size_t size)
+{
+  chunk* new_chunk = static_cast<chunk*>(std::malloc(sizeof(chunk) + size));
+  if (!new_chunk)
+    throw std::bad_alloc();
+  new_chunk->size = size;
+
+  // other threads may be searching the chunks for storage they are releasing
+  std::lock_guard<std::mutex> lock(s_arenas_mutex);
+  new_chunk->next = m_chunks;
+  m_chunks = new_chunk;
+  ++m_chunk_count;
+  return new_chunk;
+}
+
+bool scripting_arena::release(const void* storage)
+{
+  for (const chunk* current = m_chunks; current; current = current->next)
+  {
+    if (current->contains(storage))
+    {
+      m_live.fetch_sub(1, std::memory_order_relaxed);
+      return true;
+    }
+  }
+  return false;
+}
+
+void* internal::allocate_scripting(std::size_t size)
+{
+  scripting_arena* arena = s_arena;
+  return (arena ? arena->allocate(size) : ::operator new(size));
+}
+
+void internal::deallocate_scripting(void* storage) noexcept
+{
+  if (!storage)
+    return;
+
+  // storage carved from an arena is found by address, so heap storage needs no header
+  if (s_arena_count.load(std::memory_order_relaxed) != 0)
+  {
+    std::lock_guard<std::mutex> lock(s_arenas_mutex);
+    for (scripting_arena* arena : s_arenas)
+    {
+      if (arena->release(storage))
+        return;
+    }
+  }
+
+  ::operator delete(storage);
+}
@@ -0,0 +1,72 @@
+/**
+ * @file	call_log.cpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2026/10/16
+ */
+
+/* -- Includes -- */
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+#include <spookshow/spookshow.hpp>
+
+/* -- Namespaces -- */
+
+using namespace spookshow;
+using namespace spookshow::internal;
+
+/* -- Variables -- */
+
+namespace
+{
+  std::atomic<std::uint64_t> call_sequence { 0 };
+}
+
+/* -- Procedures -- */
+
+std::uint64_t spookshow::internal::next_call_sequence()
+{
+  return call_sequence.fetch_add(1, std::memory_order_relaxed);
+}
+
+std::uint64_t spookshow::internal::call_timestamp()
+{
+  const std::chrono::steady_clock::duration time = std::chrono::steady_clock::now().time_since_epoch();
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(time).count();
+}
+
+call_log_base::call_log_base(std::size_t capacity, log_policy policy, std::size_t sample_interval)
+  : m_capacity(capacity),
+    m_policy(policy),
+    m_sample_interval(sample_interval)
+{
+  if (capacity == 0)
+    handle_error("Call log capacity must not be zero!");
+  if (sample_interval == 0)
+    handle_error("Call log sample interval must not be zero!");
+}
+
+call_log_base::~call_log_base()
+{ }
+
+void call_log_base::record_guard::lock_contended()
+{
+  static const int SPIN_COUNT = 64;
+
+  for (int spins = 0; ; )
+  {
+    // only reads while the lock is held, so waiting threads do not keep taking the cache line from
+    // the thread recording, and yield if that thread is taking a while (e.g., copying arguments)
+    while (m_locked.load(std::memory_order_relaxed))
+    {
+      if (++spins >= SPIN_COUNT)
+        std::this_thread::yield();
+    }
+    if (!m_locked.exchange(true, std::memory_order_acquire))
+      return;
+  }
+}
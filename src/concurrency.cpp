@@ -0,0 +1,137 @@
+/**
+ * @file	concurrency.cpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2026/10/16
+ */
+
+/* -- Includes -- */
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include <spookshow/spookshow.hpp>
+
+/* -- Namespaces -- */
+
+using namespace spookshow::internal;
+
+/* -- Types -- */
+
+/**
+ * Part of the state which is only used while the mutex is held.
+ */
+class concurrent_state::serialized_state final
+{
+public:
+
+  /**
+   * Object which has been withdrawn, but may still be in use by a reader.
+   */
+  class retired_object final
+  {
+  public:
+    const void* object;
+    concurrent_state::deleter deleter;
+  };
+
+  std::recursive_mutex mutex;
+
+  /** Objects whose grace period has begun. */
+  std::vector<retired_object> waiting;
+
+  /** Reader counters which have not been observed at zero since the grace period began. */
+  std::uint64_t waiting_stripes { 0 };
+
+  /** Objects withdrawn since the grace period began, which wait for the next one. */
+  std::vector<retired_object> retired;
+
+};
+
+/* -- Procedures -- */
+
+concurrent_state::concurrent_state()
+  : m_published(nullptr),
+    m_retired(false),
+    m_deleter(nullptr),
+    m_serialized(new serialized_state())
+{
+  static_assert(STRIPE_COUNT <= 64, "Reader counters must fit in the waiting_stripes mask!");
+}
+
+concurrent_state::~concurrent_state()
+{
+  // nobody can be calling the method any more, so everything can be destroyed immediately
+  publish(nullptr, nullptr);
+  for (const serialized_state::retired_object& retired : m_serialized->waiting)
+    retired.deleter(retired.object);
+  for (const serialized_state::retired_object& retired : m_serialized->retired)
+    retired.deleter(retired.object);
+}
+
+void concurrent_state::lock()
+{
+  m_serialized->mutex.lock();
+}
+
+void concurrent_state::unlock()
+{
+  m_serialized->mutex.unlock();
+}
+
+void concurrent_state::publish(const void* object, deleter deleter)
+{
+  const void* previous = m_published.exchange(object, std::memory_order_seq_cst);
+  if (previous)
+  {
+    m_serialized->retired.push_back(serialized_state::retired_object { previous, m_deleter });
+    m_retired.store(true, std::memory_order_relaxed);
+  }
+  m_deleter = deleter;
+  reclaim();
+}
+
+void concurrent_state::reclaim()
+{
+  serialized_state& serialized = *m_serialized;
+  while (true)
+  {
+    if (serialized.waiting.empty())
+    {
+      if (serialized.retired.empty())
+      {
+        m_retired.store(false, std::memory_order_relaxed);
+        return;
+      }
+
+      // a reader which saw one of these objects entered before it was withdrawn, so it has left
+      // once its counter has been seen at zero from now on
+      serialized.waiting.swap(serialized.retired);
+      serialized.waiting_stripes = (STRIPE_COUNT == 64 ? ~std::uint64_t(0)
+                                                       : (std::uint64_t(1) << STRIPE_COUNT) - 1);
+    }
+
+    for (std::size_t idx = 0; idx < STRIPE_COUNT; idx++)
+    {
+      const std::uint64_t bit = (std::uint64_t(1) << idx);
+      if ((serialized.waiting_stripes & bit) &&
+          m_stripes[idx].counter.load(std::memory_order_seq_cst) == 0)
+        serialized.waiting_stripes &= ~bit;
+    }
+    if (serialized.waiting_stripes != 0)
+      return;
+
+    for (const serialized_state::retired_object& retired : serialized.waiting)
+      retired.deleter(retired.object);
+    serialized.waiting.clear();
+  }
+}
+
+void concurrent_state::reclaim_after_read()
+{
+  // readers never wait for the mutex, the next reader or change to the queue will try again
+  if (!m_serialized->mutex.try_lock())
+    return;
+  reclaim();
+  m_serialized->mutex.unlock();
+}
@@ -6,8 +6,10 @@
 
 /* -- Includes -- */
 
-#include <sstream>
+#include <atomic>
+#include <cstdint>
 #include <string>
+#include <thread>
 
 #include <spookshow/spookshow.hpp>
 
@@ -15,42 +17,137 @@
 
 using namespace spookshow;
 
+/* -- Types -- */
+
+class expectation::links
+{
+public:
+
+  /** Number of predecessors which have not been fulfilled yet. */
+  std::atomic<std::uint32_t> pending { 0 };
+
+  /** Expectations which this one must be fulfilled after. Destroyed ones are cleared. */
+  internal::compact_vector<expectation*> predecessors;
+
+  /** Expectations which must be fulfilled after this one. Destroyed ones are cleared. */
+  internal::compact_vector<expectation*> successors;
+
+  /**
+   * Removes an expectation from a list of predecessors or successors.
+   */
+  static void unlink(internal::compact_vector<expectation*>& list, const expectation* target)
+  {
+    for (expectation*& link : list)
+      if (link == target)
+        link = nullptr;
+  }
+
+};
+
 /* -- Procedures -- */
 
 expectation::expectation(const std::string& name, int required_count)
+  : expectation(expectation_order::current_order(), name, required_count)
+{ }
+
+expectation::expectation(expectation_order& order, const std::string& name, int required_count)
+  : expectation(&order, name, required_count)
+{ }
+
+expectation::expectation(expectation_order* order, const std::string& name, int required_count)
   : m_name(name),
     m_required_count(required_count),
-    m_order(expectation_order::current_order()),
-    m_count(0)
-{
-  if (m_order)
-    m_order->enqueue_expectation(this);
-}
+    m_order(order),
+    m_sequence(order ? order->enqueue_expectation() : 0),
+    m_count(order ? FIRST_PENDING : 0),
+    m_links()
+{ }
 
 expectation::~expectation()
 {
+  if (m_links)
+  {
+    for (expectation* predecessor : m_links->predecessors)
+      if (predecessor)
+        links::unlink(predecessor->m_links->successors, this);
+    for (expectation* successor : m_links->successors)
+      if (successor)
+        links::unlink(successor->m_links->predecessors, this);
+  }
+
   if (is_fulfilled())
     return;
 
-  std::ostringstream message;
-  message << "Unfulfilled expectation! [" << name()
-          << "] Expected " << m_required_count << " call" << (m_required_count == 1 ? "" : "s")
-          << ", received " << m_count << " call" << (m_count == 1 ? "" : "s") << ".";
-  internal::handle_failure(message.str());
+  const failure record {
+    failure_kind::unfulfilled_expectation, nullptr, this,
+    count(), static_cast<std::uint64_t>(m_required_count), nullptr, nullptr, 0
+  };
+  internal::handle_failure(record);
+}
+
+expectation& expectation::after(expectation& predecessor)
+{
+  if (&predecessor == this)
+    internal::handle_error("An expectation cannot be fulfilled after itself!");
+
+  // a predecessor which has already been fulfilled does not constrain anything
+  if (predecessor.count() != 0)
+    return *this;
+
+  if (!predecessor.m_links)
+    predecessor.m_links.reset(new links());
+  if (!m_links)
+    m_links.reset(new links());
+
+  predecessor.m_links->successors.emplace_back(this);
+  m_links->predecessors.emplace_back(&predecessor);
+  m_links->pending.fetch_add(1, std::memory_order_relaxed);
+
+  // an expectation which has already been fulfilled never checks its constraints
+  predecessor.m_count.fetch_or(FIRST_PENDING, std::memory_order_relaxed);
+  if (count() == 0)
+    m_count.fetch_or(FIRST_PENDING, std::memory_order_relaxed);
+  return *this;
+}
+
+void expectation::fulfill_pending(std::uint64_t previous)
+{
+  if ((previous & ~FIRST_PENDING) != 0)
+  {
+    // another thread is making the first fulfillment, and has not finished checking the order
+    while (m_count.load(std::memory_order_acquire) & FIRST_PENDING)
+      std::this_thread::yield();
+    return;
+  }
+
+  // the order is advanced before waiting threads are released, and the failure (if any) is only
+  // reported after that, so a failure handler which throws does not leave them waiting
+  const bool in_order = fulfill_first();
+  m_count.fetch_and(~FIRST_PENDING, std::memory_order_release);
+
+  if (!in_order)
+  {
+    const failure record {
+      failure_kind::out_of_order_expectation, nullptr, this,
+      count(), static_cast<std::uint64_t>(m_required_count), nullptr, nullptr, 0
+    };
+    internal::handle_failure(record);
+  }
 }
 
-void expectation::fulfill()
+bool expectation::fulfill_first()
 {
-  if (m_order && m_count == 0)
+  bool in_order = (!m_order || m_order->fulfill_expectation(m_sequence));
+  if (m_links)
   {
-    if (m_order->is_expectation_next(this))
-      m_order->dequeue_expectation();
-    else
-    {
-      std::ostringstream message;
-      message << "Expectation fulfilled out of order! [" << name() << "]";
-      internal::handle_failure(message.str());
-    }
+    if (m_links->pending.load(std::memory_order_acquire) != 0)
+      in_order = false;
+
+    // successors no longer wait for this expectation, even if it was fulfilled out of order
+    for (expectation* successor : m_links->successors)
+      if (successor)
+        successor->m_links->pending.fetch_sub(1, std::memory_order_release);
   }
-  ++m_count;
+
+  return in_order;
 }
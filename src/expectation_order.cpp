@@ -7,6 +7,8 @@
 /* -- Includes -- */
 
 #include <cstdlib>
+#include <stack>
+
 #include <spookshow/spookshow.hpp>
 
 /* -- Namespaces -- */
@@ -15,19 +17,28 @@ using namespace spookshow;
 
 /* -- Variables -- */
 
-std::stack<expectation_order*> expectation_order::s_orders;
+namespace
+{
+  /** Stack of the scoped orders created on this thread. */
+  thread_local std::stack<expectation_order*> s_orders;
+}
 
 /* -- Procedures -- */
 
-expectation_order::expectation_order()
-  : m_expectations()
+expectation_order::expectation_order(registration registration)
+  : m_registration(registration),
+    m_size(0),
+    m_next(0)
 {
-  s_orders.push(this);
+  if (m_registration == registration::scoped)
+    s_orders.push(this);
 }
 
 expectation_order::~expectation_order()
 {
-  if (s_orders.top() != this)
+  if (m_registration != registration::scoped)
+    return;
+  if (s_orders.empty() || s_orders.top() != this)
     internal::handle_error("Expectation order stack was corrupted!");
   s_orders.pop();
 }
@@ -37,17 +48,14 @@ expectation_order* expectation_order::current_order()
   return (s_orders.empty() ? nullptr : s_orders.top());
 }
 
-void expectation_order::enqueue_expectation(const expectation* exp)
-{
-  m_expectations.push(exp);
-}
-
-void expectation_order::dequeue_expectation()
+std::uint64_t expectation_order::enqueue_expectation()
 {
-  m_expectations.pop();
+  return m_size.fetch_add(1, std::memory_order_relaxed);
 }
 
-bool expectation_order::is_expectation_next(const expectation* exp) const
+bool expectation_order::fulfill_expectation(std::uint64_t sequence)
 {
-  return (m_expectations.empty() ? false : m_expectations.front() == exp);
+  // only advances if every expectation before this one has already been fulfilled
+  std::uint64_t expected = sequence;
+  return m_next.compare_exchange_strong(expected, sequence + 1, std::memory_order_acq_rel);
 }
@@ -0,0 +1,73 @@
+/**
+ * @file	failure.cpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2026/10/16
+ */
+
+/* -- Includes -- */
+
+#include <sstream>
+#include <string>
+
+#include <spookshow/spookshow.hpp>
+
+/* -- Namespaces -- */
+
+using namespace spookshow;
+
+/* -- Procedures -- */
+
+void failure::format_arguments(std::ostream& stream) const
+{
+  if (argument_formatter)
+    argument_formatter(stream, arguments);
+}
+
+std::string failure::message() const
+{
+  std::ostringstream message;
+  switch (kind)
+  {
+  case failure_kind::unexpected_call:
+    message << "Unexpected mock method call! [" << *method << "].";
+    break;
+
+  case failure_kind::unexpected_arguments:
+    message << "Mock method call with unexpected arguments! [" << *method << "].";
+    break;
+
+  case failure_kind::exhausted_stream:
+    message << "Mock method return stream has ended! [" << *method << "].";
+    break;
+
+  case failure_kind::unused_functors:
+    message << "Mock method has unused functors! [" << *method << "] "
+            << count << " functor" << (count == 1 ? " was" : "s were") << " never called.";
+    break;
+
+  case failure_kind::unfulfilled_expectation:
+    message << "Unfulfilled expectation! [" << exp->name()
+            << "] Expected " << required_count << " call" << (required_count == 1 ? "" : "s")
+            << ", received " << count << " call" << (count == 1 ? "" : "s") << ".";
+    break;
+
+  case failure_kind::out_of_order_expectation:
+    message << "Expectation fulfilled out of order! [" << exp->name() << "]";
+    break;
+  }
+
+  if (suppressed != 0)
+  {
+    message << " Repeated " << suppressed << " more time" << (suppressed == 1 ? "" : "s") << ".";
+    return message.str();
+  }
+
+  if (argument_formatter)
+  {
+    message << " Arguments: (";
+    format_arguments(message);
+    message << ").";
+  }
+
+  return message.str();
+}
@@ -0,0 +1,202 @@
+/**
+ * @file	method.cpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2026/10/16
+ */
+
+/* -- Includes -- */
+
+#include <memory>
+#include <ostream>
+#include <string>
+
+#include <spookshow/spookshow.hpp>
+
+/* -- Namespaces -- */
+
+using namespace spookshow;
+using namespace spookshow::internal;
+
+/* -- Explicit Instantiations -- */
+
+namespace spookshow
+{
+  namespace internal
+  {
+
+    template class inline_function_base<DEFAULT_INLINE_CAPACITY>;
+    template class method_core<DEFAULT_INLINE_CAPACITY>;
+    template class compact_vector<inline_function_base<DEFAULT_INLINE_CAPACITY>, scripting_allocation>;
+    template class compact_vector<expectation*, scripting_allocation>;
+    template class segmented_queue<method_core<DEFAULT_INLINE_CAPACITY>::entry>;
+
+#define SPOOKSHOW_INSTANTIATION_(tmpl, ...)							\
+    template class tmpl<__VA_ARGS__, DEFAULT_INLINE_CAPACITY>;
+    SPOOKSHOW_COMMON_INSTANTIATIONS_(SPOOKSHOW_INSTANTIATION_)
+#undef SPOOKSHOW_INSTANTIATION_
+
+  }
+}
+
+/* -- Procedures -- */
+
+std::ostream& spookshow::internal::operator <<(std::ostream& stream, const method_descriptor& descriptor)
+{
+  stream << descriptor.signature;
+  if (descriptor.qualifiers[0] != '\0')
+    stream << " " << descriptor.qualifiers;
+  return stream << " (" << descriptor.file << ":" << descriptor.line << ")";
+}
+
+void spookshow::internal::write_value(std::ostream& stream, bool value)
+{
+  stream << value;
+}
+
+void spookshow::internal::write_value(std::ostream& stream, char value)
+{
+  stream << value;
+}
+
+void spookshow::internal::write_value(std::ostream& stream, signed char value)
+{
+  stream << value;
+}
+
+void spookshow::internal::write_value(std::ostream& stream, unsigned char value)
+{
+  stream << value;
+}
+
+void spookshow::internal::write_value(std::ostream& stream, long long value)
+{
+  stream << value;
+}
+
+void spookshow::internal::write_value(std::ostream& stream, unsigned long long value)
+{
+  stream << value;
+}
+
+void spookshow::internal::write_value(std::ostream& stream, double value)
+{
+  stream << value;
+}
+
+void spookshow::internal::write_value(std::ostream& stream, long double value)
+{
+  stream << value;
+}
+
+void spookshow::internal::write_value(std::ostream& stream, const void* value)
+{
+  stream << value;
+}
+
+void spookshow::internal::write_value(std::ostream& stream, const std::string& value)
+{
+  stream << value;
+}
+
+void spookshow::internal::write_text(std::ostream& stream, const char* text)
+{
+  stream << text;
+}
+
+dispatch_table_base::~dispatch_table_base()
+{ }
+
+method_base::method_base(const method_descriptor& descriptor)
+  : m_descriptor(&descriptor)
+{ }
+
+method_base::~method_base()
+{
+  if (m_registry)
+    leave_registry();
+}
+
+void method_base::register_method(const registry_operations& operations) const
+{
+  mock_registry* registry = mock_registry::current_registry();
+  if (!registry)
+    return;
+
+  m_registry = registry;
+  m_registry_operations = &operations;
+  m_registry_previous = nullptr;
+  m_registry_next = registry->m_head;
+  if (registry->m_head)
+    registry->m_head->m_registry_previous = this;
+  registry->m_head = this;
+  ++registry->m_size;
+}
+
+void method_base::leave_registry() const
+{
+  if (m_registry_previous)
+    m_registry_previous->m_registry_next = m_registry_next;
+  else
+    m_registry->m_head = m_registry_next;
+  if (m_registry_next)
+    m_registry_next->m_registry_previous = m_registry_previous;
+  --m_registry->m_size;
+  m_registry = nullptr;
+}
+
+void method_base::enable_concurrency() const
+{
+  if (!m_concurrent)
+    m_concurrent.reset(new concurrent_state());
+}
+
+queue_lock method_base::lock_queue() const
+{
+  if (m_concurrent)
+    return queue_lock(*m_concurrent);
+  return queue_lock();
+}
+
+void method_base::withdraw_front() const
+{
+  if (m_concurrent)
+    m_concurrent->publish(nullptr, nullptr);
+}
+
+void method_base::clear_dispatch() const
+{
+  if (m_executing == 0)
+    m_dispatch.reset();
+  else if (m_dispatch)
+  {
+    m_dispatch->defer_clear();
+    m_dispatch_deferred = true;
+  }
+}
+
+void method_base::commit_dispatch() const
+{
+  m_dispatch_deferred = false;
+  if (m_dispatch && !m_dispatch->commit())
+    m_dispatch.reset();
+}
+
+void method_base::check_count(int count)
+{
+  if (count < 1 && count != INFINITE)
+    handle_error("Specified functor count was invalid!");
+}
+
+void method_base::fulfill_expectations(const compact_vector<expectation*, scripting_allocation>& expectations)
+{
+  for (expectation* exp : expectations)
+    exp->fulfill();
+}
+
+void method_base::handle_call_failure(failure_kind kind,
+                                      const void* arguments,
+                                      void (*formatter)(std::ostream& stream, const void* arguments)) const
+{
+  const failure record { kind, m_descriptor, nullptr, 0, 0, arguments, formatter, 0 };
+  handle_failure(record);
+}
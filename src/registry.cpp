@@ -0,0 +1,75 @@
+/**
+ * @file	registry.cpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2026/10/17
+ */
+
+/* -- Includes -- */
+
+#include <spookshow/spookshow.hpp>
+
+/* -- Namespaces -- */
+
+using namespace spookshow;
+using namespace spookshow::internal;
+
+/* -- Variables -- */
+
+std::atomic<std::size_t> mock_registry::s_count(0);
+
+namespace
+{
+  /** The innermost registry on this thread, or `nullptr` if there is none. */
+  thread_local mock_registry* s_registry = nullptr;
+}
+
+/* -- Procedures -- */
+
+mock_registry::mock_registry()
+  : m_previous(s_registry),
+    m_head(nullptr),
+    m_size(0)
+{
+  s_registry = this;
+  s_count.fetch_add(1, std::memory_order_relaxed);
+}
+
+mock_registry::~mock_registry()
+{
+  if (s_registry != this)
+    handle_error("Mock registry stack was corrupted!");
+  s_registry = m_previous;
+  s_count.fetch_sub(1, std::memory_order_relaxed);
+
+  // methods outliving the registry are simply forgotten
+  while (m_head)
+    m_head->leave_registry();
+}
+
+void mock_registry::reset_all()
+{
+  // resetting a method removes it from the registry
+  while (m_head)
+    m_head->m_registry_operations->reset(*m_head);
+}
+
+bool mock_registry::verify_all() const
+{
+  bool satisfied = true;
+  for (const method_base* method = m_head; method; method = method->m_registry_next)
+  {
+    const std::size_t unused = method->m_registry_operations->unused_functors(*method);
+    if (unused == 0)
+      continue;
+
+    satisfied = false;
+    const failure record { failure_kind::unused_functors, &method->descriptor(), nullptr, unused, 0, nullptr, nullptr, 0 };
+    handle_failure(record);
+  }
+  return satisfied;
+}
+
+mock_registry* mock_registry::current_registry()
+{
+  return s_registry;
+}
@@ -6,9 +6,12 @@
 
 /* -- Includes -- */
 
+#include <cstddef>
+#include <cstdint>
 #include <cstdlib>
 #include <iostream>
 #include <stdexcept>
+#include <utility>
 
 #include <spookshow/spookshow.hpp>
 
@@ -21,6 +24,42 @@ using namespace spookshow;
 namespace
 {
   fail_handler user_fail_handler;
+  failure_handler user_failure_handler;
+
+  /** The innermost failure aggregation on this thread, or `nullptr` if there is none. */
+  thread_local failure_aggregation* active_aggregation = nullptr;
+}
+
+/* -- Types -- */
+
+/**
+ * Counts of the failures seen by a `failure_aggregation`, keyed by method and failure kind.
+ */
+class failure_aggregation::entries final
+{
+public:
+
+  using key = std::pair<const internal::method_descriptor*, failure_kind>;
+
+  class key_hash final
+  {
+  public:
+    std::size_t operator ()(const key& value) const
+    {
+      return ((reinterpret_cast<std::uintptr_t>(value.first) << 3) ^ static_cast<std::size_t>(value.second));
+    }
+  };
+
+  // only the thread which created the scope counts failures in it, so this is not locked
+  internal::flat_hash_map<key, std::uint64_t, key_hash> counts;
+
+};
+
+/* -- Procedure Prototypes -- */
+
+namespace
+{
+  void report_failure(const failure& failure);
 }
 
 /* -- Procedures -- */
@@ -28,14 +67,57 @@ namespace
 void spookshow::set_fail_handler(fail_handler handler)
 {
   user_fail_handler = handler;
+  user_failure_handler = nullptr;
+}
+
+void spookshow::set_failure_handler(failure_handler handler)
+{
+  user_failure_handler = handler;
+  user_fail_handler = nullptr;
 }
 
-void spookshow::internal::handle_failure(const std::string& message)
+void spookshow::internal::handle_failure(const failure& failure)
 {
-  if (user_fail_handler)
-    user_fail_handler(message);
-  else
-    handle_error("Spookshow fail handler was not set!");
+  if (active_aggregation && !active_aggregation->should_report(failure))
+    return;
+  report_failure(failure);
+}
+
+failure_aggregation::failure_aggregation(std::uint64_t report_count)
+  : m_previous(active_aggregation),
+    m_report_count(report_count),
+    m_entries(new entries())
+{
+  active_aggregation = this;
+}
+
+failure_aggregation::~failure_aggregation()
+{
+  if (active_aggregation != this)
+    internal::handle_error("Failure aggregation stack was corrupted!");
+  active_aggregation = m_previous;
+
+  // summaries go straight to the handler, rather than to an enclosing aggregation
+  const std::uint64_t report_count = m_report_count;
+  m_entries->counts.for_each([report_count] (const entries::key& key, std::uint64_t count) {
+      if (count <= report_count)
+        return;
+      const failure summary { key.second, key.first, nullptr, 0, 0, nullptr, nullptr, count - report_count };
+      report_failure(summary);
+    });
+}
+
+bool failure_aggregation::should_report(const failure& failure)
+{
+  // expectations may be destroyed before the scope ends, so their failures are never deferred
+  if (!failure.method)
+    return true;
+
+  const entries::key key(failure.method, failure.kind);
+  std::uint64_t* count = m_entries->counts.find(key);
+  if (!count)
+    count = &m_entries->counts.insert_or_assign(key, std::uint64_t(0));
+  return (++(*count) <= m_report_count);
 }
 
 [[noreturn]] void spookshow::internal::handle_error(const std::string& message)
@@ -43,3 +125,18 @@ void spookshow::internal::handle_failure(const std::string& message)
   std::cerr << message << std::endl;
   std::abort();
 }
+
+namespace
+{
+
+  void report_failure(const failure& failure)
+  {
+    if (user_failure_handler)
+      user_failure_handler(failure);
+    else if (user_fail_handler)
+      user_fail_handler(failure.message());
+    else
+      internal::handle_error("Spookshow fail handler was not set!");
+  }
+
+}
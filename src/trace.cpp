@@ -0,0 +1,307 @@
+/**
+ * @file	trace.cpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2026/10/16
+ */
+
+/* -- Includes -- */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+  #define SPOOKSHOW_TRACE_MMAP_ 1
+#else
+  #define SPOOKSHOW_TRACE_MMAP_ 0
+#endif
+
+#include <spookshow/spookshow.hpp>
+
+/* -- Namespaces -- */
+
+using namespace spookshow;
+using namespace spookshow::internal;
+
+/* -- Constants -- */
+
+namespace
+{
+  /** Bytes at the start of every trace file. */
+  const char TRACE_MAGIC[] = { 's', 'p', 'k', 't', 'r', 'a', 'c', 'e' };
+
+  /** Version of the trace format, written after the magic bytes. */
+  const unsigned char TRACE_VERSION = 2;
+
+  /** Size of the buffer used when writing a trace. */
+  const std::size_t WRITE_BUFFER_SIZE = 1 << 20;
+
+  /** Marks a method in the trace which is not being replayed. */
+  const std::size_t NOT_REPLAYED = static_cast<std::size_t>(-1);
+}
+
+/* -- Types -- */
+
+/**
+ * Trace file being written, and the channels writing to it.
+ */
+class trace_recorder::file final
+{
+public:
+
+  std::FILE* stream { nullptr };
+  std::uint64_t next_id { 0 };
+  std::vector<std::unique_ptr<trace_channel_base>> channels;
+  trace_buffer header;
+
+  void write(const void* data, std::size_t size)
+  {
+    // empty payloads have no buffer, and fwrite() must not be passed a null pointer
+    if (size != 0 && std::fwrite(data, 1, size, stream) != size)
+      handle_error("Failed to write to trace file!");
+  }
+
+  void write_entry(std::uint64_t tag, const unsigned char* payload, std::size_t size)
+  {
+    header.clear();
+    header.write_varint(tag);
+    header.write_varint(size);
+    write(header.data(), header.size());
+    write(payload, size);
+  }
+
+};
+
+/**
+ * Trace file being replayed, and the channels reading from it.
+ */
+class trace_replayer::mapping final
+{
+public:
+
+  /**
+   * Method being replayed, and the positions of its records which have been read but not used.
+   */
+  class method final
+  {
+  public:
+
+    std::string name;
+    std::deque<std::pair<const unsigned char*, std::size_t>> pending;
+
+  };
+
+#if SPOOKSHOW_TRACE_MMAP_
+  void* address { MAP_FAILED };
+#else
+  std::vector<unsigned char> contents;
+#endif
+  const unsigned char* data { nullptr };
+  std::size_t size { 0 };
+  trace_cursor cursor { nullptr, nullptr };
+  std::vector<method> methods;
+  std::vector<std::size_t> ids;
+  std::vector<std::unique_ptr<trace_channel_base>> channels;
+
+  void load(const std::string& path);
+
+};
+
+/* -- Procedures -- */
+
+[[noreturn]] void spookshow::internal::trace_corrupt()
+{
+  handle_error("Trace file is corrupt!");
+}
+
+trace_channel_base::~trace_channel_base()
+{ }
+
+trace_recorder::trace_recorder(const std::string& path)
+  : m_file(new file()),
+    m_calls(0)
+{
+  m_file->stream = std::fopen(path.c_str(), "wb");
+  if (!m_file->stream)
+    handle_error("Failed to open trace file for writing! (" + path + ")");
+  std::setvbuf(m_file->stream, nullptr, _IOFBF, WRITE_BUFFER_SIZE);
+
+  m_file->write(TRACE_MAGIC, sizeof(TRACE_MAGIC));
+  m_file->write(&TRACE_VERSION, sizeof(TRACE_VERSION));
+}
+
+trace_recorder::~trace_recorder()
+{
+  if (std::fclose(m_file->stream) != 0)
+    handle_error("Failed to write to trace file!");
+}
+
+void trace_recorder::flush()
+{
+  if (std::fflush(m_file->stream) != 0)
+    handle_error("Failed to write to trace file!");
+}
+
+std::uint64_t trace_recorder::add_method(const std::string& name)
+{
+  // definitions have the low bit of their tag clear, and calls have it set
+  const std::uint64_t id = m_file->next_id++;
+  m_file->write_entry(id << 1, reinterpret_cast<const unsigned char*>(name.data()), name.size());
+  return id;
+}
+
+void trace_recorder::adopt(trace_channel_base* channel)
+{
+  m_file->channels.emplace_back(channel);
+}
+
+void trace_recorder::write_record(std::uint64_t id, const trace_buffer& payload)
+{
+  m_file->write_entry((id << 1) | 1, payload.data(), payload.size());
+  ++m_calls;
+}
+
+void trace_replayer::mapping::load(const std::string& path)
+{
+#if SPOOKSHOW_TRACE_MMAP_
+
+  const int descriptor = ::open(path.c_str(), O_RDONLY);
+  if (descriptor < 0)
+    handle_error("Failed to open trace file for reading! (" + path + ")");
+
+  struct stat status;
+  if (::fstat(descriptor, &status) != 0)
+    handle_error("Failed to open trace file for reading! (" + path + ")");
+  size = static_cast<std::size_t>(status.st_size);
+  if (size == 0)
+    handle_error("File is not a Spookshow trace! (" + path + ")");
+
+  // the file is paged in as it is read, so it never has to fit in memory
+  address = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+  ::close(descriptor);
+  if (address == MAP_FAILED)
+    handle_error("Failed to map trace file! (" + path + ")");
+  ::madvise(address, size, MADV_SEQUENTIAL);
+  data = static_cast<const unsigned char*>(address);
+
+#else
+
+  std::FILE* stream = std::fopen(path.c_str(), "rb");
+  if (!stream)
+    handle_error("Failed to open trace file for reading! (" + path + ")");
+
+  unsigned char chunk[1 << 16];
+  std::size_t count;
+  while ((count = std::fread(chunk, 1, sizeof(chunk), stream)) != 0)
+    contents.insert(contents.end(), chunk, chunk + count);
+  const bool failed = (std::ferror(stream) != 0);
+  std::fclose(stream);
+  if (failed)
+    handle_error("Failed to read trace file! (" + path + ")");
+  data = contents.data();
+  size = contents.size();
+
+#endif
+}
+
+trace_replayer::trace_replayer(const std::string& path)
+  : m_mapping(new mapping())
+{
+  m_mapping->load(path);
+
+  const unsigned char* data = m_mapping->data;
+  const std::size_t size = m_mapping->size;
+  if (size < sizeof(TRACE_MAGIC) + sizeof(TRACE_VERSION) ||
+      std::memcmp(data, TRACE_MAGIC, sizeof(TRACE_MAGIC)) != 0)
+    handle_error("File is not a Spookshow trace! (" + path + ")");
+  if (data[sizeof(TRACE_MAGIC)] != TRACE_VERSION)
+    handle_error("Trace file version is not supported! (" + path + ")");
+
+  m_mapping->cursor = trace_cursor(data + sizeof(TRACE_MAGIC) + sizeof(TRACE_VERSION), data + size);
+}
+
+trace_replayer::~trace_replayer()
+{
+  // channels must go before the data they point into
+  m_mapping->channels.clear();
+#if SPOOKSHOW_TRACE_MMAP_
+  if (m_mapping->address != MAP_FAILED)
+    ::munmap(m_mapping->address, m_mapping->size);
+#endif
+}
+
+std::size_t trace_replayer::add_method(const std::string& name)
+{
+  for (const mapping::method& method : m_mapping->methods)
+  {
+    if (method.name == name)
+      handle_error("Method was already replayed! (" + name + ")");
+  }
+
+  // the records of a method are only kept once it is known to be replayed
+  if (m_mapping->ids.size() != 0)
+    handle_error("Methods must be replayed before any replayed calls are made! (" + name + ")");
+
+  m_mapping->methods.emplace_back();
+  m_mapping->methods.back().name = name;
+  return m_mapping->methods.size() - 1;
+}
+
+void trace_replayer::adopt(trace_channel_base* channel)
+{
+  m_mapping->channels.emplace_back(channel);
+}
+
+bool trace_replayer::next_record(std::size_t method, trace_cursor& fields)
+{
+  mapping& state = *m_mapping;
+  std::deque<std::pair<const unsigned char*, std::size_t>>& pending = state.methods[method].pending;
+
+  while (pending.empty())
+  {
+    if (state.cursor.at_end())
+      return false;
+
+    const std::uint64_t tag = state.cursor.read_varint();
+    const std::uint64_t size = state.cursor.read_varint();
+    const unsigned char* payload = state.cursor.read_bytes(size);
+    const std::uint64_t id = (tag >> 1);
+
+    if ((tag & 1) == 0)
+    {
+      // definitions are numbered in the order they are written
+      if (id != state.ids.size())
+        trace_corrupt();
+
+      const std::string name(reinterpret_cast<const char*>(payload), size);
+      std::size_t target = NOT_REPLAYED;
+      for (std::size_t idx = 0; idx < state.methods.size(); idx++)
+      {
+        if (state.methods[idx].name == name)
+          target = idx;
+      }
+      state.ids.push_back(target);
+    }
+    else
+    {
+      if (id >= state.ids.size())
+        trace_corrupt();
+      if (state.ids[id] != NOT_REPLAYED)
+        state.methods[state.ids[id]].pending.emplace_back(payload, size);
+    }
+  }
+
+  const std::pair<const unsigned char*, std::size_t> record = pending.front();
+  pending.pop_front();
+  fields = trace_cursor(record.first, record.first + record.second);
+  return true;
+}
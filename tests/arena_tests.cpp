@@ -0,0 +1,154 @@
+/**
+ * @file	arena_tests.cpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2026/10/17
+ */
+
+/* -- Includes -- */
+
+#include <array>
+#include <memory>
+#include <thread>
+
+#include "test_base.hpp"
+
+/* -- Namespaces -- */
+
+using namespace spookshow;
+using namespace testing;
+
+/* -- Object Definition -- */
+
+namespace
+{
+
+  class object
+  {
+  public:
+    virtual ~object() = default;
+    virtual int value(int arg) = 0;
+  };
+
+  class mock : public object
+  {
+  public:
+    SPOOKSHOW_MOCK_METHOD(int, value, (int));
+  };
+
+  /**
+   * Functor too large to be stored inline.
+   */
+  class large_functor
+  {
+  public:
+    int operator ()(int arg) const { return arg + m_values[0] + m_values[15]; }
+  private:
+    std::array<int, 16> m_values {{ 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2 }};
+  };
+
+}
+
+/* -- Test Cases -- */
+
+/**
+ * Unit test for the `spookshow::scripting_arena` class.
+ */
+class ArenaTests : public ::spookshow::tests::TestBase
+{
+};
+
+TEST_F(ArenaTests, ScriptingIsCarvedFromArena)
+{
+  scripting_arena arena;
+  mock mock;
+  EXPECT_EQ(arena.allocated(), 0u);
+
+  SPOOKSHOW(mock, value).once(large_functor());
+  EXPECT_GT(arena.allocated(), 0u);
+
+  const std::size_t allocated = arena.allocated();
+  SPOOKSHOW(mock, value).once(returns(1)).requires([] (int arg) { return arg > 0; });
+  EXPECT_GT(arena.allocated(), allocated);
+  EXPECT_EQ(arena.chunks(), 1u);
+}
+
+TEST_F(ArenaTests, MocksOperateNormally)
+{
+  scripting_arena arena;
+  mock mock;
+  expectation exp;
+
+  SPOOKSHOW(mock, value).once(large_functor()).fulfills(exp);
+  SPOOKSHOW(mock, value).repeats(2, returns(5)).requires([] (int arg) { return arg == 10; });
+  SPOOKSHOW(mock, value).always(returns(7));
+
+  EXPECT_EQ(mock.value(1), 4);
+  EXPECT_TRUE(exp.is_fulfilled());
+  EXPECT_EQ(mock.value(10), 5);
+  EXPECT_EQ(mock.value(10), 5);
+  EXPECT_EQ(mock.value(10), 7);
+  EXPECT_NOT_FAILED();
+}
+
+TEST_F(ArenaTests, ChunksGrowForLargeScripts)
+{
+  scripting_arena arena(256);
+  mock mock;
+  for (int idx = 0; idx < 1000; idx++)
+    SPOOKSHOW(mock, value).once(large_functor()).requires([] (int) { return true; });
+  EXPECT_GT(arena.chunks(), 1u);
+
+  for (int idx = 0; idx < 1000; idx++)
+    EXPECT_EQ(mock.value(idx), idx + 3);
+  EXPECT_NOT_FAILED();
+}
+
+TEST_F(ArenaTests, InnermostArenaIsUsed)
+{
+  scripting_arena outer;
+  mock mock;
+  {
+    scripting_arena inner;
+    {
+      // the mock is destroyed before the inner arena
+      ::mock inner_mock;
+      SPOOKSHOW(inner_mock, value).once(large_functor());
+      EXPECT_GT(inner.allocated(), 0u);
+      EXPECT_EQ(outer.allocated(), 0u);
+    }
+  }
+
+  SPOOKSHOW(mock, value).once(large_functor());
+  EXPECT_GT(outer.allocated(), 0u);
+  EXPECT_EQ(mock.value(0), 3);
+  EXPECT_NOT_FAILED();
+}
+
+TEST_F(ArenaTests, StorageFromBeforeArenaIsReleased)
+{
+  std::unique_ptr<mock> mock_ptr(new mock());
+  SPOOKSHOW(*mock_ptr, value).once(large_functor()).requires([] (int arg) { return arg == 1; });
+
+  scripting_arena arena;
+  SPOOKSHOW(*mock_ptr, value).once(large_functor());
+  EXPECT_EQ(mock_ptr->value(1), 4);
+  EXPECT_EQ(mock_ptr->value(2), 5);
+
+  // the mock holds storage carved from the arena, so it must be destroyed first
+  mock_ptr.reset();
+  EXPECT_NOT_FAILED();
+}
+
+TEST_F(ArenaTests, StorageCanBeReleasedOnAnotherThread)
+{
+  scripting_arena arena;
+  std::unique_ptr<mock> mock_ptr(new mock());
+  SPOOKSHOW(*mock_ptr, value).always(large_functor()).requires([] (int arg) { return arg >= 0; });
+
+  std::thread thread([&mock_ptr] {
+      EXPECT_EQ(mock_ptr->value(0), 3);
+      mock_ptr.reset();
+    });
+  thread.join();
+  EXPECT_NOT_FAILED();
+}
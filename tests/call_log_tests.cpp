@@ -0,0 +1,215 @@
+/**
+ * @file	call_log_tests.cpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2026/10/16
+ */
+
+/* -- Includes -- */
+
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include "test_base.hpp"
+
+/* -- Namespaces -- */
+
+using namespace spookshow;
+using namespace testing;
+
+/* -- Object Definition -- */
+
+namespace
+{
+
+  class object
+  {
+  public:
+    virtual void send(int id, const std::string& payload) { }
+    virtual int poll() { return 0; }
+  };
+
+  class mock : public object
+  {
+  public:
+    SPOOKSHOW_MOCK_METHOD(void, send, (int, const std::string&));
+    SPOOKSHOW_MOCK_METHOD(int, poll, ());
+  };
+
+}
+
+/* -- Test Cases -- */
+
+/**
+ * Unit test for the `spookshow::call_log` class.
+ */
+class CallLogTests : public ::spookshow::tests::TestBase
+{
+protected:
+  mock m_mock;
+};
+
+TEST_F(CallLogTests, RecordsArgumentsOfEachCall)
+{
+  call_log<int, const std::string&>& log = SPOOKSHOW(m_mock, send).spy(8);
+  m_mock.send(1, "one");
+  m_mock.send(2, "two");
+
+  EXPECT_NOT_FAILED();
+  EXPECT_EQ(log.size(), 2u);
+  EXPECT_EQ(log.calls(), 2u);
+  EXPECT_EQ(log[0].arguments, std::make_tuple(1, std::string("one")));
+  EXPECT_EQ(log[1].arguments, std::make_tuple(2, std::string("two")));
+  EXPECT_LT(log[0].sequence, log[1].sequence);
+  EXPECT_LE(log[0].timestamp, log[1].timestamp);
+}
+
+TEST_F(CallLogTests, CallsWithEmptyQueueReturnDefaultValue)
+{
+  SPOOKSHOW(m_mock, poll).spy(8);
+  EXPECT_EQ(m_mock.poll(), 0);
+  EXPECT_NOT_FAILED();
+}
+
+TEST_F(CallLogTests, QueuedFunctorsAreStillExecuted)
+{
+  SPOOKSHOW(m_mock, poll).spy(8);
+  SPOOKSHOW(m_mock, poll).once(returns(5));
+  EXPECT_EQ(m_mock.poll(), 5);
+  EXPECT_EQ(m_mock.poll(), 0);
+  EXPECT_EQ(SPOOKSHOW(m_mock, poll).log().size(), 2u);
+}
+
+TEST_F(CallLogTests, ConditionFailuresAreStillReported)
+{
+  SPOOKSHOW(m_mock, send).spy(8);
+  SPOOKSHOW(m_mock, send).once(noops()).requires(arg_eq<0>(1));
+  m_mock.send(2, "two");
+  EXPECT_FAILED();
+  EXPECT_EQ(SPOOKSHOW(m_mock, send).log().size(), 1u);
+  SPOOKSHOW(m_mock, send).reset();
+}
+
+TEST_F(CallLogTests, OverwritesOldestRecordsWhenFull)
+{
+  call_log<int, const std::string&>& log = SPOOKSHOW(m_mock, send).spy(3);
+  for (int idx = 0; idx < 10; idx++)
+    m_mock.send(idx, "payload");
+
+  EXPECT_EQ(log.size(), 3u);
+  EXPECT_EQ(log.calls(), 10u);
+  EXPECT_EQ(std::get<0>(log.front().arguments), 7);
+  EXPECT_EQ(std::get<0>(log.back().arguments), 9);
+}
+
+TEST_F(CallLogTests, KeepsOldestRecordsWhenRequested)
+{
+  call_log<int, const std::string&>& log = SPOOKSHOW(m_mock, send).spy(3, log_policy::keep_oldest);
+  for (int idx = 0; idx < 10; idx++)
+    m_mock.send(idx, "payload");
+
+  EXPECT_EQ(log.size(), 3u);
+  EXPECT_EQ(log.calls(), 10u);
+  EXPECT_EQ(std::get<0>(log.front().arguments), 0);
+  EXPECT_EQ(std::get<0>(log.back().arguments), 2);
+}
+
+TEST_F(CallLogTests, SamplesEveryNthCall)
+{
+  call_log<int, const std::string&>& log = SPOOKSHOW(m_mock, send).spy(100, log_policy::overwrite_oldest, 4);
+  for (int idx = 0; idx < 10; idx++)
+    m_mock.send(idx, "payload");
+
+  ASSERT_EQ(log.size(), 3u);
+  EXPECT_EQ(std::get<0>(log[0].arguments), 0);
+  EXPECT_EQ(std::get<0>(log[1].arguments), 4);
+  EXPECT_EQ(std::get<0>(log[2].arguments), 8);
+}
+
+TEST_F(CallLogTests, CountsRecordsMatchingCondition)
+{
+  call_log<int, const std::string&>& log = SPOOKSHOW(m_mock, send).spy(100);
+  for (int idx = 0; idx < 10; idx++)
+    m_mock.send(idx % 3, (idx % 2 == 0 ? "even" : "odd"));
+
+  EXPECT_EQ(log.count(arg_eq<0>(0)), 4u);
+  EXPECT_EQ(log.count(arg_eq<1>(std::string("even"))), 5u);
+  EXPECT_EQ(log.count(arg_eq<0>(0) && arg_eq<1>(std::string("odd"))), 2u);
+}
+
+TEST_F(CallLogTests, ClearRemovesRecords)
+{
+  call_log<int, const std::string&>& log = SPOOKSHOW(m_mock, send).spy(8);
+  m_mock.send(1, "one");
+  log.clear();
+  EXPECT_TRUE(log.empty());
+  EXPECT_EQ(log.calls(), 1u);
+}
+
+TEST_F(CallLogTests, SequenceNumbersOrderCallsAcrossMethods)
+{
+  SPOOKSHOW(m_mock, send).spy(8);
+  SPOOKSHOW(m_mock, poll).spy(8);
+  m_mock.send(1, "one");
+  m_mock.poll();
+  m_mock.send(2, "two");
+
+  EXPECT_LT(SPOOKSHOW(m_mock, send).log()[0].sequence, SPOOKSHOW(m_mock, poll).log()[0].sequence);
+  EXPECT_LT(SPOOKSHOW(m_mock, poll).log()[0].sequence, SPOOKSHOW(m_mock, send).log()[1].sequence);
+}
+
+TEST_F(CallLogTests, RecordsCallsFromSeveralThreads)
+{
+  const int THREAD_COUNT = 4;
+  const int CALL_COUNT = 1000;
+
+  SPOOKSHOW(m_mock, send).enable_concurrency();
+  call_log<int, const std::string&>& log = SPOOKSHOW(m_mock, send).spy(THREAD_COUNT * CALL_COUNT);
+
+  std::vector<std::thread> threads;
+  for (int thread = 0; thread < THREAD_COUNT; thread++)
+    threads.emplace_back([this, thread] {
+        for (int idx = 0; idx < CALL_COUNT; idx++)
+          m_mock.send(thread, "payload");
+      });
+  for (std::thread& thread : threads)
+    thread.join();
+
+  EXPECT_NOT_FAILED();
+  EXPECT_EQ(log.size(), static_cast<std::size_t>(THREAD_COUNT * CALL_COUNT));
+  for (int thread = 0; thread < THREAD_COUNT; thread++)
+    EXPECT_EQ(log.count(arg_eq<0>(thread)), static_cast<std::size_t>(CALL_COUNT));
+}
+
+TEST_F(CallLogTests, CallCountCanBeReadWhileRecording)
+{
+  const int THREAD_COUNT = 4;
+  const int CALL_COUNT = 1000;
+
+  SPOOKSHOW(m_mock, send).enable_concurrency();
+  call_log<int, const std::string&>& log = SPOOKSHOW(m_mock, send).spy(16, log_policy::overwrite_oldest);
+
+  std::vector<std::thread> threads;
+  for (int thread = 0; thread < THREAD_COUNT; thread++)
+    threads.emplace_back([this, thread] {
+        for (int idx = 0; idx < CALL_COUNT; idx++)
+          m_mock.send(thread, "payload");
+      });
+
+  // the count never goes backwards, and reaches the total once every thread is done
+  std::uint64_t last = 0;
+  while (last != static_cast<std::uint64_t>(THREAD_COUNT * CALL_COUNT))
+  {
+    const std::uint64_t calls = log.calls();
+    EXPECT_GE(calls, last);
+    last = calls;
+    std::this_thread::yield();
+  }
+
+  for (std::thread& thread : threads)
+    thread.join();
+  EXPECT_NOT_FAILED();
+  EXPECT_EQ(log.size(), 16u);
+}
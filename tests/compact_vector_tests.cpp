@@ -0,0 +1,76 @@
+/**
+ * @file	compact_vector_tests.cpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2026/10/16
+ */
+
+/* -- Includes -- */
+
+#include <memory>
+
+#include "test_base.hpp"
+
+/* -- Namespaces -- */
+
+using namespace spookshow;
+using namespace spookshow::internal;
+using namespace testing;
+
+/* -- Test Cases -- */
+
+/**
+ * Unit test for the `spookshow::internal::compact_vector` class.
+ */
+class CompactVectorTests : public ::spookshow::tests::TestBase
+{
+};
+
+TEST_F(CompactVectorTests, StoresElementsInOrder)
+{
+  compact_vector<int> vector;
+  EXPECT_TRUE(vector.empty());
+  for (int idx = 0; idx < 100; idx++)
+    vector.emplace_back(idx);
+
+  EXPECT_EQ(vector.size(), 100u);
+  int expected = 0;
+  for (int value : vector)
+    EXPECT_EQ(value, expected++);
+}
+
+TEST_F(CompactVectorTests, MoveTransfersElements)
+{
+  compact_vector<std::unique_ptr<int>> original;
+  original.emplace_back(new int(5));
+
+  compact_vector<std::unique_ptr<int>> moved(std::move(original));
+  EXPECT_TRUE(original.empty());
+  ASSERT_EQ(moved.size(), 1u);
+  EXPECT_EQ(**moved.begin(), 5);
+}
+
+TEST_F(CompactVectorTests, ClearDestroysElements)
+{
+  auto token = std::make_shared<int>(0);
+  compact_vector<std::shared_ptr<int>> vector;
+  for (int idx = 0; idx < 10; idx++)
+    vector.emplace_back(token);
+  EXPECT_EQ(token.use_count(), 11);
+
+  vector.clear();
+  EXPECT_TRUE(vector.empty());
+  EXPECT_EQ(token.use_count(), 1);
+}
+
+TEST_F(CompactVectorTests, ReserveKeepsElementsInPlace)
+{
+  compact_vector<int> vector;
+  vector.reserve(100);
+  vector.emplace_back(0);
+  const int* first = vector.begin();
+  for (int idx = 1; idx < 100; idx++)
+    vector.emplace_back(idx);
+
+  EXPECT_EQ(vector.begin(), first);
+  EXPECT_EQ(vector[99], 99);
+}
@@ -13,6 +13,40 @@
 using namespace spookshow;
 using namespace testing;
 
+/* -- Types -- */
+
+namespace
+{
+
+  /**
+   * Value type which counts how many times it has been copied, and compares equal to zero.
+   */
+  class copy_counter
+  {
+  public:
+    explicit copy_counter(int& copies) : m_copies(&copies) { }
+    copy_counter(const copy_counter& other) : m_copies(other.m_copies) { ++(*m_copies); }
+    copy_counter(copy_counter&& other) = default;
+    friend bool operator ==(int value, const copy_counter&) { return (value == 0); }
+    friend bool operator !=(int value, const copy_counter&) { return (value != 0); }
+  private:
+    int* m_copies;
+  };
+
+  /**
+   * Creates a condition which counts its evaluations and returns a fixed result.
+   */
+  auto counting_condition(int& evaluated, bool result)
+  {
+    auto lambda = [&evaluated, result] (const auto&...) {
+      ++evaluated;
+      return result;
+    };
+    return spookshow::internal::condition_functor<decltype(lambda)>(lambda);
+  }
+
+}
+
 /* -- Test Cases -- */
 
 /**
@@ -80,3 +114,87 @@ TEST_F(ConditionTests, NotOperator)
   EXPECT_EQ(cond(100), false);		// ! T
   EXPECT_EQ(cond(101), true);		// ! F
 }
+
+TEST_F(ConditionTests, ArgEqDoesNotCopyArguments)
+{
+  class no_copy
+  {
+  public:
+    explicit no_copy(int value) : m_value(value) { }
+    no_copy(const no_copy&) = delete;
+    bool operator ==(int value) const { return (m_value == value); }
+    bool operator !=(int value) const { return (m_value != value); }
+  private:
+    int m_value;
+  };
+
+  no_copy first(1);
+  no_copy second(2);
+  EXPECT_TRUE(arg_eq<1>(2)(first, second));
+  EXPECT_FALSE(arg_ne<0>(1)(first, second));
+}
+
+TEST_F(ConditionTests, ArgEqSelectsLastOfManyArguments)
+{
+  auto cond = arg_eq<5>(std::string("last"));
+  EXPECT_TRUE(cond(0, 1.0, 'c', "d", false, std::string("last")));
+  EXPECT_FALSE(cond(0, 1.0, 'c', "d", false, std::string("first")));
+}
+
+TEST_F(ConditionTests, ChainedAndIsFlattened)
+{
+  auto cond = arg_eq<0>(1) && arg_eq<1>(2) && arg_eq<2>(3) && arg_eq<3>(4);
+  EXPECT_EQ(std::tuple_size<std::decay_t<decltype(cond.operands())>>::value, 4u);
+  EXPECT_TRUE(cond(1, 2, 3, 4));
+  EXPECT_FALSE(cond(1, 2, 3, 5));
+}
+
+TEST_F(ConditionTests, ChainedOrIsFlattened)
+{
+  auto first = arg_eq<0>(1) || arg_eq<0>(2);
+  auto second = arg_eq<0>(3) || arg_eq<0>(4);
+  auto cond = first || second;
+  EXPECT_EQ(std::tuple_size<std::decay_t<decltype(cond.operands())>>::value, 4u);
+  EXPECT_TRUE(cond(3));
+  EXPECT_FALSE(cond(5));
+}
+
+TEST_F(ConditionTests, DoubleNegationCancelsOut)
+{
+  auto cond0 = arg_eq<0>(100);
+  auto cond = !!cond0;
+  EXPECT_TRUE((std::is_same<decltype(cond), decltype(cond0)>::value));
+  EXPECT_TRUE(cond(100));
+  EXPECT_FALSE(cond(101));
+}
+
+TEST_F(ConditionTests, AndShortCircuits)
+{
+  int evaluated = 0;
+  auto cond = arg_eq<0>(1) && counting_condition(evaluated, true);
+  EXPECT_FALSE(cond(2));
+  EXPECT_EQ(evaluated, 0);
+  EXPECT_TRUE(cond(1));
+  EXPECT_EQ(evaluated, 1);
+}
+
+TEST_F(ConditionTests, OrShortCircuits)
+{
+  int evaluated = 0;
+  auto cond = arg_eq<0>(1) || counting_condition(evaluated, false);
+  EXPECT_TRUE(cond(1));
+  EXPECT_EQ(evaluated, 0);
+  EXPECT_FALSE(cond(2));
+  EXPECT_EQ(evaluated, 1);
+}
+
+TEST_F(ConditionTests, ComposingTemporariesDoesNotCopyCapturedValues)
+{
+  int copies = 0;
+  auto cond =
+    (arg_eq<0>(copy_counter(copies)) && arg_ne<1>(copy_counter(copies))) &&
+    (arg_eq<2>(copy_counter(copies)) && !arg_ne<3>(copy_counter(copies)));
+  EXPECT_EQ(copies, 0);
+  EXPECT_TRUE(cond(0, 1, 0, 0));
+  EXPECT_EQ(copies, 0);
+}
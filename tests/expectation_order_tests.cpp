@@ -6,6 +6,10 @@
 
 /* -- Includes -- */
 
+#include <memory>
+#include <thread>
+#include <vector>
+
 #include "test_base.hpp"
 
 /* -- Namespaces -- */
@@ -86,3 +90,210 @@ TEST_F(ExpectationOrderTests, ExpectationOrderStackOperatesCorrectly)
   outer_exp3.fulfill();
   EXPECT_FAILED();
 }
+
+TEST_F(ExpectationOrderTests, ScopedOrdersArePerThread)
+{
+  expectation_order order;
+  expectation exp1;
+
+  // expectations on another thread do not join this thread's order, and its orders do not disturb ours
+  std::thread thread([] {
+      expectation unordered;
+      expectation_order thread_order;
+      expectation thread_exp1;
+      expectation thread_exp2;
+      thread_exp1.fulfill();
+      thread_exp2.fulfill();
+      unordered.fulfill();
+    });
+  thread.join();
+  EXPECT_NOT_FAILED();
+
+  expectation exp2;
+  exp1.fulfill();
+  exp2.fulfill();
+  EXPECT_NOT_FAILED();
+}
+
+TEST_F(ExpectationOrderTests, ExplicitOrderIsNotJoinedAutomatically)
+{
+  expectation_order order(expectation_order::registration::explicit_only);
+
+  expectation exp1;
+  expectation exp2(order);
+  expectation exp3;
+
+  exp3.fulfill();
+  exp2.fulfill();
+  exp1.fulfill();
+  EXPECT_NOT_FAILED();
+}
+
+TEST_F(ExpectationOrderTests, ExplicitOrderOverridesScopedOrder)
+{
+  expectation_order scoped_order;
+  expectation_order explicit_order(expectation_order::registration::explicit_only);
+
+  expectation scoped_exp;
+  expectation explicit_exp1(explicit_order, "First");
+  expectation explicit_exp2(explicit_order, "Second");
+
+  explicit_exp1.fulfill();
+  scoped_exp.fulfill();
+  explicit_exp2.fulfill();
+  EXPECT_NOT_FAILED();
+}
+
+TEST_F(ExpectationOrderTests, ExplicitOrderDoesNotFailIfThreadsFulfillInOrder)
+{
+  expectation_order order(expectation_order::registration::explicit_only);
+  expectation exp1(order);
+  expectation exp2(order);
+
+  std::thread thread1([&exp1] { exp1.fulfill(); });
+  thread1.join();
+  std::thread thread2([&exp2] { exp2.fulfill(); });
+  thread2.join();
+
+  EXPECT_NOT_FAILED();
+}
+
+TEST_F(ExpectationOrderTests, ExplicitOrderFailsIfThreadsFulfillOutOfOrder)
+{
+  expectation_order order(expectation_order::registration::explicit_only);
+  expectation exp1(order);
+  expectation exp2(order);
+
+  std::thread thread2([&exp2] { exp2.fulfill(); });
+  thread2.join();
+  EXPECT_FAILED();
+
+  reset_failed();
+  exp1.fulfill();
+  EXPECT_NOT_FAILED();
+}
+
+TEST_F(ExpectationOrderTests, PartialOrderAllowsPredecessorsInAnyOrder)
+{
+  expectation a;
+  expectation b;
+  expectation c;
+  c.after(a).after(b);
+
+  b.fulfill();
+  a.fulfill();
+  c.fulfill();
+  EXPECT_NOT_FAILED();
+}
+
+TEST_F(ExpectationOrderTests, PartialOrderFailsIfSuccessorFulfilledFirst)
+{
+  expectation a;
+  expectation b;
+  expectation c;
+  c.after(a).after(b);
+
+  a.fulfill();
+  c.fulfill();
+  EXPECT_FAILED();
+  EXPECT_NE(m_fail_message.find("out of order"), std::string::npos);
+
+  reset_failed();
+  b.fulfill();
+  EXPECT_NOT_FAILED();
+}
+
+TEST_F(ExpectationOrderTests, PartialOrderIsOnlyCheckedOnFirstFulfillment)
+{
+  expectation a;
+  expectation b(2);
+  b.after(a);
+
+  a.fulfill();
+  b.fulfill();
+  b.fulfill();
+  EXPECT_NOT_FAILED();
+}
+
+TEST_F(ExpectationOrderTests, FulfilledPredecessorDoesNotConstrain)
+{
+  expectation a;
+  a.fulfill();
+
+  expectation b;
+  b.after(a);
+  b.fulfill();
+  EXPECT_NOT_FAILED();
+}
+
+TEST_F(ExpectationOrderTests, PartialOrderCombinesWithTotalOrder)
+{
+  expectation independent;
+  expectation_order order;
+  expectation first;
+  expectation second;
+  second.after(independent);
+
+  first.fulfill();
+  second.fulfill();
+  EXPECT_FAILED();
+
+  reset_failed();
+  independent.fulfill();
+  EXPECT_NOT_FAILED();
+}
+
+TEST_F(ExpectationOrderTests, PartialOrderScalesToManyPredecessors)
+{
+  const int PREDECESSOR_COUNT = 10000;
+
+  std::vector<std::unique_ptr<expectation>> predecessors;
+  expectation last;
+  for (int idx = 0; idx < PREDECESSOR_COUNT; idx++)
+  {
+    predecessors.emplace_back(new expectation());
+    last.after(*predecessors.back());
+  }
+
+  for (int idx = PREDECESSOR_COUNT - 1; idx >= 0; idx--)
+    predecessors[idx]->fulfill();
+  last.fulfill();
+  EXPECT_NOT_FAILED();
+}
+
+TEST_F(ExpectationOrderTests, SuccessorMayBeDestroyedBeforePredecessor)
+{
+  expectation predecessor;
+  {
+    expectation successor;
+    successor.after(predecessor);
+    successor.fulfill();
+    EXPECT_FAILED();
+  }
+
+  reset_failed();
+  predecessor.fulfill();
+  EXPECT_NOT_FAILED();
+}
+
+TEST_F(ExpectationOrderTests, PartialOrderMayBeFulfilledFromSeveralThreads)
+{
+  const int THREAD_COUNT = 4;
+
+  std::vector<std::unique_ptr<expectation>> predecessors;
+  expectation last;
+  for (int idx = 0; idx < THREAD_COUNT; idx++)
+  {
+    predecessors.emplace_back(new expectation());
+    last.after(*predecessors.back());
+  }
+
+  std::vector<std::thread> threads;
+  for (int idx = 0; idx < THREAD_COUNT; idx++)
+    threads.emplace_back([&predecessors, idx] { predecessors[idx]->fulfill(); });
+  for (std::thread& thread : threads)
+    thread.join();
+
+  std::thread([&last] { last.fulfill(); }).join();
+  EXPECT_NOT_FAILED();
+}
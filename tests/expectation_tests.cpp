@@ -6,6 +6,12 @@
 
 /* -- Includes -- */
 
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
 #include "test_base.hpp"
 
 /* -- Namespaces -- */
@@ -86,3 +92,76 @@ TEST_F(ExpectationTests, ExpectationFailureMessageReportsExpectationName)
   EXPECT_FAILED();
   EXPECT_NE(m_fail_message.find(EXPECTED_NAME), std::string::npos);
 }
+
+TEST_F(ExpectationTests, CountReportsNumberOfFulfillments)
+{
+  static_assert(std::is_same<decltype(std::declval<expectation>().count()), std::uint64_t>::value,
+                "Expectation counts must be 64-bit!");
+
+  expectation exp;
+  EXPECT_EQ(exp.count(), 0u);
+  exp.fulfill();
+  exp.fulfill();
+  EXPECT_EQ(exp.count(), 2u);
+}
+
+TEST_F(ExpectationTests, FulfillmentsFromManyThreadsAreAllCounted)
+{
+  static const int THREAD_COUNT = 8;
+  static const int FULFILL_COUNT = 10000;
+
+  expectation exp(THREAD_COUNT * FULFILL_COUNT);
+  std::vector<std::thread> threads;
+  for (int idx = 0; idx < THREAD_COUNT; idx++)
+    threads.emplace_back([&exp] {
+        for (int fulfill = 0; fulfill < FULFILL_COUNT; fulfill++)
+          exp.fulfill();
+      });
+  for (std::thread& thread : threads)
+    thread.join();
+
+  EXPECT_EQ(exp.count(), static_cast<std::uint64_t>(THREAD_COUNT * FULFILL_COUNT));
+  EXPECT_TRUE(exp.is_fulfilled());
+}
+
+TEST_F(ExpectationTests, OrderIsOnlyCheckedOnFirstFulfillment)
+{
+  expectation_order order;
+  expectation exp1;
+  expectation exp2;
+
+  exp1.fulfill();
+  exp2.fulfill();
+  exp1.fulfill();
+  exp2.fulfill();
+  EXPECT_NOT_FAILED();
+}
+
+TEST_F(ExpectationTests, ConcurrentFulfillmentsWaitForOrderToAdvance)
+{
+  static const int THREAD_COUNT = 4;
+  static const int ROUND_COUNT = 500;
+
+  // each thread fulfills the first expectation and then the second, so the second must never see
+  // the order still waiting for the first, whichever thread made the first fulfillment
+  for (int round = 0; round < ROUND_COUNT; round++)
+  {
+    expectation_order order;
+    expectation first(order, "first", THREAD_COUNT);
+    expectation second(order, "second", THREAD_COUNT);
+
+    std::atomic<int> ready(0);
+    std::vector<std::thread> threads;
+    for (int idx = 0; idx < THREAD_COUNT; idx++)
+      threads.emplace_back([&] {
+          ready.fetch_add(1);
+          while (ready.load() != THREAD_COUNT)
+            std::this_thread::yield();
+          first.fulfill();
+          second.fulfill();
+        });
+    for (std::thread& thread : threads)
+      thread.join();
+  }
+  EXPECT_NOT_FAILED();
+}
@@ -0,0 +1,318 @@
+/**
+ * @file	failure_tests.cpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2026/10/16
+ */
+
+/* -- Includes -- */
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <thread>
+
+#include "test_base.hpp"
+
+/* -- Namespaces -- */
+
+using namespace spookshow;
+using namespace testing;
+
+/* -- Object Definition -- */
+
+namespace
+{
+
+  /**
+   * Argument type which counts how many times it has been written to a stream.
+   */
+  class format_counter
+  {
+  public:
+    explicit format_counter(int& formats) : m_formats(&formats) { }
+    int* m_formats;
+  };
+
+  std::ostream& operator <<(std::ostream& stream, const format_counter& counter)
+  {
+    ++(*counter.m_formats);
+    return stream << "counter";
+  }
+
+  /**
+   * Argument type which cannot be written to a stream.
+   */
+  class unprintable { };
+
+  /**
+   * Scoped enumeration without a stream operator.
+   */
+  enum class color { red, green = 4 };
+
+  class object
+  {
+  public:
+    virtual void no_args() { }
+    virtual void two_args(int value1, int value2) { }
+    virtual void counted(const format_counter& counter) { }
+    virtual void mixed(int value, unprintable other, const char* text) { }
+    virtual void values(const std::string& text, color color, short number, char letter, double real) { }
+  };
+
+  class mock : public object
+  {
+  public:
+    SPOOKSHOW_MOCK_METHOD_0(void, no_args);
+    SPOOKSHOW_MOCK_METHOD_2(void, two_args, int, int);
+    SPOOKSHOW_MOCK_METHOD_1(void, counted, const format_counter&);
+    SPOOKSHOW_MOCK_METHOD_3(void, mixed, int, unprintable, const char*);
+    SPOOKSHOW_MOCK_METHOD(void, values, (const std::string&, color, short, char, double));
+  };
+
+}
+
+/* -- Test Cases -- */
+
+/**
+ * Unit test for the `spookshow::failure` class.
+ */
+class FailureTests : public ::spookshow::tests::TestBase
+{
+protected:
+
+  mock m_mock;
+  int m_failures { 0 };
+  failure_kind m_kind { failure_kind::unexpected_call };
+  std::string m_method_name;
+  std::uint64_t m_count { 0 };
+  std::uint64_t m_required_count { 0 };
+  std::uint64_t m_suppressed { 0 };
+
+  void capture_records()
+  {
+    spookshow::set_failure_handler([this] (const failure& record) {
+        ++m_failures;
+        m_kind = record.kind;
+        m_method_name = (record.method ? record.method->name : "");
+        m_count = record.count;
+        m_required_count = record.required_count;
+        m_suppressed = record.suppressed;
+      });
+  }
+
+};
+
+TEST_F(FailureTests, HandlerReceivesUnexpectedCallRecord)
+{
+  capture_records();
+  m_mock.two_args(1, 2);
+  EXPECT_EQ(m_failures, 1);
+  EXPECT_EQ(m_kind, failure_kind::unexpected_call);
+  EXPECT_EQ(m_method_name, "two_args");
+}
+
+TEST_F(FailureTests, HandlerReceivesUnexpectedArgumentsRecord)
+{
+  capture_records();
+  SPOOKSHOW(m_mock, two_args).once(noops()).requires(arg_eq<0>(5));
+  m_mock.two_args(1, 2);
+  EXPECT_EQ(m_failures, 1);
+  EXPECT_EQ(m_kind, failure_kind::unexpected_arguments);
+  EXPECT_EQ(m_method_name, "two_args");
+  SPOOKSHOW(m_mock, two_args).reset();
+}
+
+TEST_F(FailureTests, HandlerReceivesUnfulfilledExpectationRecord)
+{
+  capture_records();
+  {
+    expectation exp(3);
+    exp.fulfill();
+  }
+  EXPECT_EQ(m_failures, 1);
+  EXPECT_EQ(m_kind, failure_kind::unfulfilled_expectation);
+  EXPECT_EQ(m_count, 1u);
+  EXPECT_EQ(m_required_count, 3u);
+}
+
+TEST_F(FailureTests, HandlerReceivesOutOfOrderRecord)
+{
+  capture_records();
+  expectation_order order;
+  expectation exp1;
+  expectation exp2;
+  exp2.fulfill();
+  EXPECT_EQ(m_failures, 1);
+  EXPECT_EQ(m_kind, failure_kind::out_of_order_expectation);
+  exp1.fulfill();
+}
+
+TEST_F(FailureTests, ArgumentsAreOnlyFormattedWhenMessageIsRequested)
+{
+  int formats = 0;
+  capture_records();
+  m_mock.counted(format_counter(formats));
+  EXPECT_EQ(m_failures, 1);
+  EXPECT_EQ(formats, 0);
+
+  spookshow::set_failure_handler([] (const failure& record) {
+      record.message();
+    });
+  m_mock.counted(format_counter(formats));
+  EXPECT_EQ(formats, 1);
+}
+
+TEST_F(FailureTests, MessageIncludesArguments)
+{
+  m_mock.two_args(1, 2);
+  EXPECT_FAILED();
+  EXPECT_NE(m_fail_message.find("Unexpected mock method call!"), std::string::npos);
+  EXPECT_NE(m_fail_message.find("Arguments: (1, 2)."), std::string::npos);
+}
+
+TEST_F(FailureTests, MessageOmitsArgumentsForMethodWithoutParameters)
+{
+  m_mock.no_args();
+  EXPECT_FAILED();
+  EXPECT_EQ(m_fail_message.find("Arguments"), std::string::npos);
+}
+
+TEST_F(FailureTests, UnprintableArgumentsAndPointersAreNotDereferenced)
+{
+  m_mock.mixed(7, unprintable(), nullptr);
+  EXPECT_FAILED();
+  EXPECT_NE(m_fail_message.find("Arguments: (7, ?, "), std::string::npos);
+}
+
+TEST_F(FailureTests, MessageFormatsFundamentalsStringsAndEnumerations)
+{
+  m_mock.values("text", color::green, -3, 'x', 0.5);
+  EXPECT_FAILED();
+  EXPECT_NE(m_fail_message.find("Arguments: (text, 4, -3, x, 0.5)."), std::string::npos);
+}
+
+TEST_F(FailureTests, SettingFailHandlerReplacesFailureHandler)
+{
+  capture_records();
+  set_fail_handler([this] (const std::string& message) {
+      m_failed = true;
+      m_fail_message = message;
+    });
+  m_mock.no_args();
+  EXPECT_FAILED();
+  EXPECT_EQ(m_failures, 0);
+}
+
+TEST_F(FailureTests, AggregationReportsFirstFailuresThenSummary)
+{
+  capture_records();
+  {
+    failure_aggregation aggregation(2);
+    for (int idx = 0; idx < 10; idx++)
+      m_mock.two_args(idx, idx);
+    EXPECT_EQ(m_failures, 2);
+    EXPECT_EQ(m_suppressed, 0u);
+  }
+  EXPECT_EQ(m_failures, 3);
+  EXPECT_EQ(m_kind, failure_kind::unexpected_call);
+  EXPECT_EQ(m_method_name, "two_args");
+  EXPECT_EQ(m_suppressed, 8u);
+}
+
+TEST_F(FailureTests, AggregationCountsMethodsAndKindsSeparately)
+{
+  capture_records();
+  {
+    failure_aggregation aggregation(1);
+    SPOOKSHOW(m_mock, two_args).always(noops()).requires(arg_eq<0>(0));
+    for (int idx = 0; idx < 5; idx++)
+    {
+      m_mock.no_args();
+      m_mock.two_args(1, 1);
+    }
+    SPOOKSHOW(m_mock, two_args).reset();
+    for (int idx = 0; idx < 5; idx++)
+      m_mock.two_args(1, 1);
+    EXPECT_EQ(m_failures, 3);
+  }
+  EXPECT_EQ(m_failures, 6);
+}
+
+TEST_F(FailureTests, AggregationDoesNotReportSummaryIfNothingWasSuppressed)
+{
+  capture_records();
+  {
+    failure_aggregation aggregation(3);
+    m_mock.no_args();
+    m_mock.no_args();
+  }
+  EXPECT_EQ(m_failures, 2);
+}
+
+TEST_F(FailureTests, AggregationDoesNotDeferExpectationFailures)
+{
+  capture_records();
+  failure_aggregation aggregation(0);
+  {
+    expectation exp;
+  }
+  EXPECT_EQ(m_failures, 1);
+  EXPECT_EQ(m_kind, failure_kind::unfulfilled_expectation);
+}
+
+TEST_F(FailureTests, NestedAggregationRestoresEnclosingScope)
+{
+  capture_records();
+  {
+    failure_aggregation outer(1);
+    {
+      failure_aggregation inner(1);
+      m_mock.no_args();
+      m_mock.no_args();
+      EXPECT_EQ(m_failures, 1);
+    }
+    EXPECT_EQ(m_failures, 2);
+
+    m_mock.no_args();
+    m_mock.no_args();
+    EXPECT_EQ(m_failures, 3);
+  }
+  EXPECT_EQ(m_failures, 4);
+}
+
+TEST_F(FailureTests, AggregationOnlyCoversItsOwnThread)
+{
+  capture_records();
+  {
+    failure_aggregation aggregation(1);
+
+    // failures on another thread are reported immediately, and its own scope ends with it
+    std::thread thread([this] {
+        for (int idx = 0; idx < 3; idx++)
+          m_mock.no_args();
+        failure_aggregation other(1);
+        for (int idx = 0; idx < 3; idx++)
+          m_mock.two_args(idx, idx);
+      });
+    thread.join();
+    EXPECT_EQ(m_failures, 5);
+    EXPECT_EQ(m_suppressed, 2u);
+
+    m_mock.no_args();
+    m_mock.no_args();
+    EXPECT_EQ(m_failures, 6);
+  }
+  EXPECT_EQ(m_failures, 7);
+  EXPECT_EQ(m_suppressed, 1u);
+}
+
+TEST_F(FailureTests, SummaryMessageReportsRepeatCount)
+{
+  {
+    failure_aggregation aggregation(1);
+    for (int idx = 0; idx < 4; idx++)
+      m_mock.no_args();
+  }
+  EXPECT_FAILED();
+  EXPECT_NE(m_fail_message.find("Repeated 3 more times."), std::string::npos);
+}
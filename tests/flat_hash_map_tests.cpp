@@ -0,0 +1,100 @@
+/**
+ * @file	flat_hash_map_tests.cpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2026/10/16
+ */
+
+/* -- Includes -- */
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+#include "test_base.hpp"
+
+/* -- Namespaces -- */
+
+using namespace spookshow;
+using namespace spookshow::internal;
+using namespace testing;
+
+/* -- Test Cases -- */
+
+/**
+ * Unit test for the `spookshow::internal::flat_hash_map` class.
+ */
+class FlatHashMapTests : public ::spookshow::tests::TestBase
+{
+};
+
+TEST_F(FlatHashMapTests, FindsNothingWhenEmpty)
+{
+  flat_hash_map<int, int> map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.find(0), nullptr);
+}
+
+TEST_F(FlatHashMapTests, FindsInsertedValuesAfterGrowing)
+{
+  const int COUNT = 10000;
+  flat_hash_map<int, int> map;
+  for (int key = 0; key < COUNT; key++)
+    map.insert_or_assign(key * 1024, key);
+
+  EXPECT_EQ(map.size(), static_cast<std::size_t>(COUNT));
+  for (int key = 0; key < COUNT; key++)
+  {
+    const int* value = map.find(key * 1024);
+    ASSERT_NE(value, nullptr);
+    EXPECT_EQ(*value, key);
+  }
+  EXPECT_EQ(map.find(1), nullptr);
+}
+
+TEST_F(FlatHashMapTests, InsertingExistingKeyReplacesValue)
+{
+  flat_hash_map<std::string, std::string> map;
+  map.insert_or_assign(std::string("key"), std::string("first"));
+  map.insert_or_assign(std::string("key"), std::string("second"));
+  EXPECT_EQ(map.size(), 1u);
+  EXPECT_EQ(*map.find("key"), "second");
+}
+
+TEST_F(FlatHashMapTests, VisitsEachElementOnce)
+{
+  flat_hash_map<int, int> map;
+  for (int key = 0; key < 100; key++)
+    map.insert_or_assign(key, key * 2);
+
+  int visits = 0;
+  int total = 0;
+  map.for_each([&] (const int& key, int& value) {
+      EXPECT_EQ(value, key * 2);
+      ++visits;
+      total += key;
+    });
+  EXPECT_EQ(visits, 100);
+  EXPECT_EQ(total, 99 * 100 / 2);
+}
+
+TEST_F(FlatHashMapTests, HoldsMoveOnlyValues)
+{
+  flat_hash_map<int, std::unique_ptr<int>> map;
+  for (int key = 0; key < 100; key++)
+    map.insert_or_assign(key, std::make_unique<int>(key));
+  EXPECT_EQ(**map.find(42), 42);
+}
+
+TEST_F(FlatHashMapTests, ClearDestroysElements)
+{
+  std::shared_ptr<int> shared = std::make_shared<int>(0);
+  flat_hash_map<int, std::shared_ptr<int>> map;
+  for (int key = 0; key < 10; key++)
+    map.insert_or_assign(key, shared);
+  EXPECT_EQ(shared.use_count(), 11);
+
+  map.clear();
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(shared.use_count(), 1);
+  EXPECT_EQ(map.find(3), nullptr);
+}
@@ -0,0 +1,125 @@
+/**
+ * @file	inline_function_tests.cpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2026/10/16
+ */
+
+/* -- Includes -- */
+
+#include <array>
+#include <memory>
+#include <string>
+
+#include "test_base.hpp"
+
+/* -- Namespaces -- */
+
+using namespace spookshow;
+using namespace spookshow::internal;
+using namespace testing;
+
+/* -- Test Cases -- */
+
+/**
+ * Unit test for the `spookshow::internal::inline_function` class.
+ */
+class InlineFunctionTests : public ::spookshow::tests::TestBase
+{
+protected:
+  using small_function = inline_function<int(int), DEFAULT_INLINE_CAPACITY>;
+};
+
+TEST_F(InlineFunctionTests, DefaultConstructedFunctionIsEmpty)
+{
+  small_function function;
+  EXPECT_FALSE(static_cast<bool>(function));
+}
+
+TEST_F(InlineFunctionTests, InvokesSmallCallable)
+{
+  int offset = 10;
+  small_function function([offset] (int value) { return value + offset; });
+  EXPECT_TRUE(static_cast<bool>(function));
+  EXPECT_EQ(function(5), 15);
+}
+
+TEST_F(InlineFunctionTests, InvokesCallableLargerThanCapacity)
+{
+  std::array<int, 64> values;
+  values.fill(3);
+  small_function function([values] (int index) { return values[index]; });
+  EXPECT_EQ(function(63), 3);
+}
+
+TEST_F(InlineFunctionTests, CopiesCallable)
+{
+  std::string suffix = "a string long enough to defeat the small string optimization";
+  inline_function<std::string(), DEFAULT_INLINE_CAPACITY> original([suffix] { return suffix; });
+  auto copy = original;
+  EXPECT_EQ(original(), suffix);
+  EXPECT_EQ(copy(), suffix);
+}
+
+TEST_F(InlineFunctionTests, MovesCallable)
+{
+  small_function original([] (int value) { return value * 2; });
+  small_function moved(std::move(original));
+  EXPECT_FALSE(static_cast<bool>(original));
+  EXPECT_EQ(moved(21), 42);
+}
+
+TEST_F(InlineFunctionTests, DestroysCallable)
+{
+  auto token = std::make_shared<int>(0);
+  // for scope
+  {
+    small_function function([token] (int value) { return value; });
+    EXPECT_EQ(token.use_count(), 2);
+  }
+  EXPECT_EQ(token.use_count(), 1);
+}
+
+TEST_F(InlineFunctionTests, AcceptsMoveOnlyCallable)
+{
+  auto pointer = std::make_unique<int>(7);
+  small_function function([pointer = std::move(pointer)] (int value) { return value + *pointer; });
+  EXPECT_EQ(function(1), 8);
+}
+
+TEST_F(InlineFunctionTests, AcceptsMutableCallable)
+{
+  small_function function([count = 0] (int value) mutable { return value + (++count); });
+  EXPECT_EQ(function(0), 1);
+  EXPECT_EQ(function(0), 2);
+}
+
+TEST_F(InlineFunctionTests, AcceptsLvalueArguments)
+{
+  const std::string text = "text";
+  inline_function<std::size_t(std::string), DEFAULT_INLINE_CAPACITY> function([] (std::string value) { return value.size(); });
+  EXPECT_EQ(function(text), 4u);
+}
+
+TEST_F(InlineFunctionTests, DetectsConstCallables)
+{
+  std::array<int, 64> values {};
+  EXPECT_TRUE(small_function().const_callable());
+  EXPECT_TRUE(small_function([] (int value) { return value; }).const_callable());
+  EXPECT_TRUE(small_function([values] (int index) { return values[index]; }).const_callable());
+  EXPECT_FALSE(small_function([count = 0] (int value) mutable { return value + (++count); }).const_callable());
+  EXPECT_FALSE(small_function([values] (int index) mutable { return ++values[index]; }).const_callable());
+}
+
+TEST_F(InlineFunctionTests, InvokesThroughBase)
+{
+  auto token = std::make_shared<int>(3);
+  inline_function_base<DEFAULT_INLINE_CAPACITY> base = small_function([token] (int value) { return value * *token; });
+  EXPECT_TRUE(base);
+  EXPECT_TRUE(base.copyable());
+  EXPECT_EQ(token.use_count(), 2);
+  EXPECT_EQ(small_function::call(base, 2), 6);
+
+  inline_function_base<DEFAULT_INLINE_CAPACITY> copy = base;
+  EXPECT_EQ(token.use_count(), 3);
+  EXPECT_EQ(small_function::call(copy, 4), 12);
+}
@@ -6,6 +6,13 @@
 
 /* -- Includes -- */
 
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
 #include "test_base.hpp"
 
 /* -- Namespaces -- */
@@ -54,6 +61,84 @@ namespace
     SPOOKSHOW_MOCK_METHOD_0(std::string, returns_string);
   };
 
+  /**
+   * Argument type which counts how many times it has been copied.
+   */
+  class copy_counter
+  {
+  public:
+    copy_counter() : m_copies(nullptr) { }
+    copy_counter(int& copies) : m_copies(&copies) { }
+    copy_counter(const copy_counter& other) : m_copies(other.m_copies) { if (m_copies) ++(*m_copies); }
+    copy_counter(copy_counter&& other) = default;
+    copy_counter& operator =(const copy_counter& other) = delete;
+  private:
+    int* m_copies;
+  };
+
+  /**
+   * Sample object with methods taking large or move-only arguments.
+   */
+  class payload_object
+  {
+  public:
+    virtual void by_value(copy_counter counter) { }
+    virtual void by_reference(const copy_counter& counter) { }
+    virtual int by_unique_ptr(std::unique_ptr<int> pointer) { return 0; }
+    virtual std::size_t by_vector(std::vector<int> values) { return 0; }
+    virtual copy_counter returns_counter() { return copy_counter(); }
+    virtual std::unique_ptr<int> returns_unique_ptr() { return nullptr; }
+    virtual const std::string& returns_const_ref() { static const std::string value; return value; }
+    virtual int& returns_ref() { static int value; return value; }
+  };
+
+  /**
+   * A mock object for the `payload_object` class.
+   */
+  class payload_mock : public payload_object
+  {
+  public:
+    SPOOKSHOW_MOCK_METHOD_1(void, by_value, copy_counter);
+    SPOOKSHOW_MOCK_METHOD_1(void, by_reference, const copy_counter&);
+    SPOOKSHOW_MOCK_METHOD_1(int, by_unique_ptr, std::unique_ptr<int>);
+    SPOOKSHOW_MOCK_METHOD_1(std::size_t, by_vector, std::vector<int>);
+    SPOOKSHOW_MOCK_METHOD_0(copy_counter, returns_counter);
+    SPOOKSHOW_MOCK_METHOD_0(std::unique_ptr<int>, returns_unique_ptr);
+    SPOOKSHOW_MOCK_METHOD_0(const std::string&, returns_const_ref);
+    SPOOKSHOW_MOCK_METHOD_0(int&, returns_ref);
+  };
+
+  /**
+   * Sample object with methods which the per-arity macros cannot mock.
+   */
+  class wide_object
+  {
+  public:
+    virtual int eight_args(int a, int b, int c, int d, int e, int f, int g, int h) { return 0; }
+    virtual int const_noexcept(int value) const noexcept { return 0; }
+    virtual int lvalue_only() & { return 0; }
+    virtual int rvalue_only() && { return 0; }
+    virtual void start() { }
+    virtual bool running() const { return false; }
+    virtual int take(std::unique_ptr<int> pointer, const std::string& name) { return 0; }
+  };
+
+  /**
+   * A mock object for the `wide_object` class.
+   */
+  class wide_mock : public wide_object
+  {
+  public:
+    SPOOKSHOW_MOCK_METHOD(int, eight_args, (int, int, int, int, int, int, int, int));
+    SPOOKSHOW_MOCK_METHOD(int, const_noexcept, (int), (const, noexcept));
+    SPOOKSHOW_MOCK_METHOD(int, lvalue_only, (), (&));
+    SPOOKSHOW_MOCK_METHOD(int, rvalue_only, (), (&&));
+    SPOOKSHOW_MOCK_METHODS(
+      (void, start, ()),
+      (bool, running, (), (const)),
+      (int, take, (std::unique_ptr<int>, const std::string&)));
+  };
+
 }
 
 /* -- Test Cases -- */
@@ -399,3 +484,911 @@ TEST_F(MethodTests, ExpectAlwaysMacroFails)
   }
   EXPECT_FAILED();
 }
+
+TEST_F(MethodTests, FailureMessageReportsMethodSignature)
+{
+  m_mock.int_two_args(1, 2);
+  EXPECT_FAILED();
+  EXPECT_NE(m_fail_message.find("int int_two_args(int, int)"), std::string::npos);
+  EXPECT_NE(m_fail_message.find(__FILE__), std::string::npos);
+}
+
+TEST_F(MethodTests, FailureMessageReportsMethodQualifiers)
+{
+  m_mock.void_no_args();
+  EXPECT_FAILED();
+  EXPECT_NE(m_fail_message.find("void void_no_args() const"), std::string::npos);
+}
+
+TEST_F(MethodTests, DescriptorIsSharedBetweenInstances)
+{
+  mock other;
+  EXPECT_EQ(&SPOOKSHOW(m_mock, void_one_arg).descriptor(), &SPOOKSHOW(other, void_one_arg).descriptor());
+  EXPECT_STREQ(SPOOKSHOW(m_mock, void_one_arg).descriptor().name, "void_one_arg");
+}
+
+TEST_F(MethodTests, MockWithCustomInlineCapacityAcceptsLargeActions)
+{
+  class large_mock : public object
+  {
+  public:
+    SPOOKSHOW_INLINE_CAPACITY(128);
+    SPOOKSHOW_MOCK_METHOD_1(int, int_one_arg, int);
+  };
+
+  large_mock mock;
+  int a = 1, b = 2, c = 3, d = 4, e = 5;
+  SPOOKSHOW(mock, int_one_arg).once([a, b, c, d, e] (int value) {
+      return value + a + b + c + d + e;
+    });
+  EXPECT_EQ(mock.int_one_arg(0), 15);
+  EXPECT_NOT_FAILED();
+}
+
+TEST_F(MethodTests, ReserveKeepsEntriesStable)
+{
+  SPOOKSHOW(m_mock, void_one_arg).reserve(100);
+  auto first = SPOOKSHOW(m_mock, void_one_arg).once(noops());
+  for (int idx = 0; idx < 99; idx++)
+    SPOOKSHOW(m_mock, void_one_arg).once(noops());
+
+  // the first entry must still be valid after enqueuing the others
+  first.requires(arg_eq<0>(10));
+  m_mock.void_one_arg(11);
+  EXPECT_FAILED();
+}
+
+TEST_F(MethodTests, EntriesAreStableWithoutReserve)
+{
+  auto& first = SPOOKSHOW(m_mock, void_one_arg).once(noops());
+  for (int idx = 0; idx < 100; idx++)
+    SPOOKSHOW(m_mock, void_one_arg).once(noops());
+
+  // enqueuing far more functors than the first block holds must not move the first entry
+  first.requires(arg_eq<0>(10));
+  m_mock.void_one_arg(11);
+  EXPECT_FAILED();
+}
+
+TEST_F(MethodTests, OnceFunctorMayEnqueueOnItsOwnMethod)
+{
+  bool second_called = false;
+  SPOOKSHOW(m_mock, void_no_args).once([&] {
+      SPOOKSHOW(m_mock, void_no_args).once([&] {
+          second_called = true;
+        });
+    });
+
+  m_mock.void_no_args();
+  m_mock.void_no_args();
+  EXPECT_TRUE(second_called);
+  EXPECT_NOT_FAILED();
+}
+
+TEST_F(MethodTests, OnceFunctorMayResetItsOwnMethod)
+{
+  SPOOKSHOW(m_mock, void_no_args).once([&] {
+      SPOOKSHOW(m_mock, void_no_args).reset();
+    });
+  SPOOKSHOW(m_mock, void_no_args).always(noops());
+
+  m_mock.void_no_args();
+  EXPECT_NOT_FAILED();
+
+  m_mock.void_no_args();
+  EXPECT_FAILED();
+}
+
+TEST_F(MethodTests, AlwaysFunctorMayResetItsOwnMethod)
+{
+  std::vector<int> values { 1, 2, 3 };
+  int sum = 0;
+  SPOOKSHOW(m_mock, void_no_args).always([this, &sum, values] {
+      SPOOKSHOW(m_mock, void_no_args).reset();
+
+      // the captures must outlive the reset, since this functor is still running
+      for (int value : values)
+        sum += value;
+    });
+
+  m_mock.void_no_args();
+  EXPECT_EQ(sum, 6);
+  EXPECT_NOT_FAILED();
+
+  m_mock.void_no_args();
+  EXPECT_FAILED();
+}
+
+TEST_F(MethodTests, RepeatsFunctorMaySkipItself)
+{
+  std::string label = "repeats";
+  std::string last;
+  SPOOKSHOW(m_mock, int_no_args).repeats(3, [this, &last, label] {
+      SPOOKSHOW(m_mock, int_no_args).skip();
+      last = label;
+      return 1;
+    });
+  SPOOKSHOW(m_mock, int_no_args).once(returns(2));
+
+  EXPECT_EQ(m_mock.int_no_args(), 1);
+  EXPECT_EQ(last, "repeats");
+  EXPECT_EQ(m_mock.int_no_args(), 2);
+  EXPECT_NOT_FAILED();
+}
+
+TEST_F(MethodTests, AlwaysFunctorMayEnqueueOnItsOwnMethod)
+{
+  int calls = 0;
+  SPOOKSHOW(m_mock, int_no_args).always([this, &calls] {
+      // enqueue enough functors to grow the queue while this one is running
+      for (int idx = 0; idx < 100; idx++)
+        SPOOKSHOW(m_mock, int_no_args).once(returns(idx));
+      SPOOKSHOW(m_mock, int_no_args).skip();
+      return ++calls;
+    });
+
+  EXPECT_EQ(m_mock.int_no_args(), 1);
+  for (int idx = 0; idx < 100; idx++)
+    EXPECT_EQ(m_mock.int_no_args(), idx);
+  EXPECT_EQ(calls, 1);
+  EXPECT_NOT_FAILED();
+}
+
+TEST_F(MethodTests, RepeatsFunctorMayCallItsOwnMethod)
+{
+  // the last of the three calls is made while the first two are still running
+  SPOOKSHOW(m_mock, int_one_arg).repeats(3, [this] (int value) {
+      return (value == 0 ? 0 : 1 + m_mock.int_one_arg(value - 1));
+    });
+  SPOOKSHOW(m_mock, int_one_arg).once(returns(7));
+
+  EXPECT_EQ(m_mock.int_one_arg(2), 2);
+  EXPECT_EQ(m_mock.int_one_arg(5), 7);
+  EXPECT_NOT_FAILED();
+}
+
+TEST_F(MethodTests, FunctorsKeepOrderWhenQueueGrowsWithMixedCaptures)
+{
+  static const int COUNT = 1000;
+  std::string last;
+
+  // functors capturing a string cannot be relocated with memcpy(), those capturing an int can
+  for (int idx = 0; idx < COUNT; idx++)
+  {
+    if (idx % 3 == 0)
+    {
+      std::string value = std::to_string(idx);
+      SPOOKSHOW(m_mock, void_no_args).once([&last, value] { last = value; });
+    }
+    else
+      SPOOKSHOW(m_mock, void_no_args).once([&last, idx] { last = std::to_string(idx); });
+  }
+
+  for (int idx = 0; idx < COUNT; idx++)
+  {
+    m_mock.void_no_args();
+    EXPECT_EQ(last, std::to_string(idx));
+  }
+  EXPECT_NOT_FAILED();
+}
+
+TEST_F(MethodTests, ByValueArgumentIsNotCopiedByConditionsOrFunctor)
+{
+  payload_mock mock;
+  int copies = 0;
+  SPOOKSHOW(mock, by_value)
+    .once([] (const copy_counter&) { })
+    .requires([] (const copy_counter&) { return true; });
+
+  mock.by_value(copy_counter(copies));
+  EXPECT_EQ(copies, 0);
+  EXPECT_NOT_FAILED();
+}
+
+TEST_F(MethodTests, ByReferenceArgumentIsNotCopied)
+{
+  payload_mock mock;
+  int copies = 0;
+  copy_counter counter(copies);
+  SPOOKSHOW(mock, by_reference)
+    .always(noops())
+    .requires([&] (const copy_counter& argument) { return (&argument == &counter); });
+
+  mock.by_reference(counter);
+  mock.by_reference(counter);
+  EXPECT_EQ(copies, 0);
+  EXPECT_NOT_FAILED();
+}
+
+TEST_F(MethodTests, MoveOnlyArgumentIsForwardedToFunctor)
+{
+  payload_mock mock;
+  SPOOKSHOW(mock, by_unique_ptr)
+    .once([] (std::unique_ptr<int> pointer) { return *pointer; })
+    .requires([] (const std::unique_ptr<int>& pointer) { return (pointer != nullptr); });
+
+  EXPECT_EQ(mock.by_unique_ptr(std::make_unique<int>(42)), 42);
+  EXPECT_NOT_FAILED();
+}
+
+TEST_F(MethodTests, LargeArgumentIsNotCopiedIntoFunctor)
+{
+  payload_mock mock;
+  std::vector<int> values(1000, 1);
+  const int* data = values.data();
+  SPOOKSHOW(mock, by_vector).once([data] (std::vector<int>&& argument) {
+      return (argument.data() == data ? argument.size() : 0);
+    });
+
+  EXPECT_EQ(mock.by_vector(std::move(values)), 1000u);
+  EXPECT_NOT_FAILED();
+}
+
+TEST_F(MethodTests, VariadicMacroMocksMethodWithManyArguments)
+{
+  wide_mock mock;
+  SPOOKSHOW(mock, eight_args)
+    .once([] (int a, int b, int c, int d, int e, int f, int g, int h) { return a + b + c + d + e + f + g + h; })
+    .requires(arg_eq<7>(8));
+
+  EXPECT_EQ(mock.eight_args(1, 2, 3, 4, 5, 6, 7, 8), 36);
+  EXPECT_NOT_FAILED();
+
+  mock.eight_args(1, 2, 3, 4, 5, 6, 7, 8);
+  EXPECT_FAILED();
+  EXPECT_NE(m_fail_message.find("int eight_args(int, int, int, int, int, int, int, int)"), std::string::npos);
+}
+
+TEST_F(MethodTests, VariadicMacroReportsQualifiers)
+{
+  const wide_mock mock;
+  mock.const_noexcept(1);
+  EXPECT_FAILED();
+  EXPECT_NE(m_fail_message.find("int const_noexcept(int) const noexcept"), std::string::npos);
+}
+
+TEST_F(MethodTests, VariadicMacroSupportsRefQualifiers)
+{
+  wide_mock mock;
+  SPOOKSHOW(mock, lvalue_only).once(returns(1));
+  SPOOKSHOW(mock, rvalue_only).once(returns(2));
+  EXPECT_EQ(mock.lvalue_only(), 1);
+  EXPECT_EQ(std::move(mock).rvalue_only(), 2);
+  EXPECT_STREQ(SPOOKSHOW(mock, rvalue_only).descriptor().qualifiers, "&&");
+  EXPECT_NOT_FAILED();
+}
+
+TEST_F(MethodTests, MockMethodsMacroDeclaresEachMethod)
+{
+  wide_mock mock;
+  SPOOKSHOW(mock, start).once(noops());
+  SPOOKSHOW(mock, running).once(returns(true));
+  SPOOKSHOW(mock, take).once([] (std::unique_ptr<int> pointer, const std::string& name) {
+      return *pointer + static_cast<int>(name.size());
+    });
+
+  mock.start();
+  EXPECT_TRUE(mock.running());
+  EXPECT_EQ(mock.take(std::make_unique<int>(40), "ab"), 42);
+  EXPECT_NOT_FAILED();
+}
+
+TEST_F(MethodTests, ConcurrentModeKeepsQueueOrder)
+{
+  SPOOKSHOW(m_mock, int_no_args).enable_concurrency();
+  EXPECT_TRUE(SPOOKSHOW(m_mock, int_no_args).concurrent());
+  SPOOKSHOW(m_mock, int_no_args).once(returns(1));
+  SPOOKSHOW(m_mock, int_no_args).repeats(2, returns(2));
+  SPOOKSHOW(m_mock, int_no_args).always(returns(3));
+
+  EXPECT_EQ(m_mock.int_no_args(), 1);
+  EXPECT_EQ(m_mock.int_no_args(), 2);
+  EXPECT_EQ(m_mock.int_no_args(), 2);
+  EXPECT_EQ(m_mock.int_no_args(), 3);
+  EXPECT_EQ(m_mock.int_no_args(), 3);
+  EXPECT_NOT_FAILED();
+
+  SPOOKSHOW(m_mock, int_no_args).skip();
+  m_mock.int_no_args();
+  EXPECT_FAILED();
+}
+
+TEST_F(MethodTests, ConcurrentModeChecksConditionsOnPublishedEntry)
+{
+  SPOOKSHOW(m_mock, int_one_arg).enable_concurrency();
+  SPOOKSHOW(m_mock, int_one_arg).always(returns(1)).requires(arg_eq<0>(5));
+
+  EXPECT_EQ(m_mock.int_one_arg(5), 1);
+  EXPECT_EQ(m_mock.int_one_arg(5), 1);
+  EXPECT_NOT_FAILED();
+
+  m_mock.int_one_arg(6);
+  EXPECT_FAILED();
+}
+
+TEST_F(MethodTests, ConcurrentAlwaysEntryMayBeCalledFromManyThreads)
+{
+  static const int THREAD_COUNT = 8;
+  static const int CALL_COUNT = 10000;
+
+  SPOOKSHOW(m_mock, int_one_arg).enable_concurrency();
+  SPOOKSHOW(m_mock, int_one_arg).always([] (int value) { return value * 2; });
+
+  std::atomic<long> total { 0 };
+  std::vector<std::thread> threads;
+  for (int idx = 0; idx < THREAD_COUNT; idx++)
+    threads.emplace_back([this, &total] {
+        for (int call = 0; call < CALL_COUNT; call++)
+          total += m_mock.int_one_arg(1);
+      });
+  for (std::thread& thread : threads)
+    thread.join();
+
+  EXPECT_EQ(total, 2L * THREAD_COUNT * CALL_COUNT);
+  EXPECT_NOT_FAILED();
+}
+
+TEST_F(MethodTests, ConcurrentRepeatsEntryIsCalledExactlyCountTimes)
+{
+  static const int THREAD_COUNT = 8;
+  static const int CALL_COUNT = 1000;
+
+  std::atomic<int> calls { 0 };
+  SPOOKSHOW(m_mock, void_one_arg).enable_concurrency();
+  SPOOKSHOW(m_mock, void_one_arg).repeats(THREAD_COUNT * CALL_COUNT, [&calls] (int) { ++calls; });
+
+  std::vector<std::thread> threads;
+  for (int idx = 0; idx < THREAD_COUNT; idx++)
+    threads.emplace_back([this] {
+        for (int call = 0; call < CALL_COUNT; call++)
+          m_mock.void_one_arg(call);
+      });
+  for (std::thread& thread : threads)
+    thread.join();
+
+  EXPECT_EQ(calls, THREAD_COUNT * CALL_COUNT);
+  EXPECT_NOT_FAILED();
+
+  m_mock.void_one_arg(0);
+  EXPECT_FAILED();
+}
+
+TEST_F(MethodTests, ConcurrentQueueMayBeModifiedWhileBeingCalled)
+{
+  static const int THREAD_COUNT = 4;
+  static const int SWAP_COUNT = 1000;
+
+  SPOOKSHOW(m_mock, int_no_args).enable_concurrency();
+  SPOOKSHOW(m_mock, int_no_args).always(returns(0));
+
+  std::atomic<bool> done { false };
+  std::atomic<int> bad_results { 0 };
+  std::vector<std::thread> threads;
+  for (int idx = 0; idx < THREAD_COUNT; idx++)
+    threads.emplace_back([this, &done, &bad_results] {
+        while (!done)
+          if (m_mock.int_no_args() > SWAP_COUNT)
+            ++bad_results;
+      });
+
+  // the queue always holds at least one entry, so no call should ever be unexpected
+  for (int swap = 1; swap <= SWAP_COUNT; swap++)
+  {
+    SPOOKSHOW(m_mock, int_no_args).always(returns(swap));
+    SPOOKSHOW(m_mock, int_no_args).skip();
+  }
+  done = true;
+  for (std::thread& thread : threads)
+    thread.join();
+
+  EXPECT_EQ(m_mock.int_no_args(), SWAP_COUNT);
+  EXPECT_EQ(bad_results, 0);
+  EXPECT_NOT_FAILED();
+}
+
+TEST_F(MethodTests, ConcurrentWithdrawnEntriesAreReclaimedByCallers)
+{
+  static const int SWAP_COUNT = 100;
+
+  // every copy of an entry holds a reference to the token
+  std::shared_ptr<int> token = std::make_shared<int>(0);
+  std::atomic<bool> blocking { false };
+  std::atomic<bool> entered { false };
+  std::atomic<bool> released { false };
+  SPOOKSHOW(m_mock, int_no_args).enable_concurrency();
+  SPOOKSHOW(m_mock, int_no_args).always([token, &blocking, &entered, &released] {
+      if (blocking.exchange(false))
+      {
+        entered = true;
+        while (!released)
+          std::this_thread::yield();
+      }
+      return 0;
+    });
+  EXPECT_EQ(m_mock.int_no_args(), 0);
+
+  // a call in progress on the published copy keeps every copy withdrawn meanwhile alive
+  blocking = true;
+  std::thread thread([this] { m_mock.int_no_args(); });
+  while (!entered)
+    std::this_thread::yield();
+  for (int swap = 1; swap <= SWAP_COUNT; swap++)
+  {
+    SPOOKSHOW(m_mock, int_no_args).always([token, swap] { return swap; });
+    SPOOKSHOW(m_mock, int_no_args).skip();
+    EXPECT_EQ(m_mock.int_no_args(), swap);
+  }
+  EXPECT_GT(token.use_count(), SWAP_COUNT);
+
+  // the queue is not changed again, so the withdrawn copies are destroyed when the call returns
+  released = true;
+  thread.join();
+  EXPECT_EQ(token.use_count(), 3);
+  EXPECT_NOT_FAILED();
+}
+
+TEST_F(MethodTests, ConcurrentAlwaysFunctorMayResetItsOwnMethod)
+{
+  int calls = 0;
+  SPOOKSHOW(m_mock, void_no_args).enable_concurrency();
+  SPOOKSHOW(m_mock, void_no_args).always([this, &calls] {
+      if (++calls == 2)
+        SPOOKSHOW(m_mock, void_no_args).reset();
+    });
+
+  // the second call runs the published copy, which must survive being withdrawn by its own functor
+  m_mock.void_no_args();
+  m_mock.void_no_args();
+  EXPECT_EQ(calls, 2);
+  EXPECT_NOT_FAILED();
+
+  m_mock.void_no_args();
+  EXPECT_FAILED();
+}
+
+TEST_F(MethodTests, ConcurrentModeGivesSameResultsForStatefulFunctors)
+{
+  mock plain;
+  mock shared;
+  SPOOKSHOW(shared, int_no_args).enable_concurrency();
+  for (mock* target : { &plain, &shared })
+  {
+    SPOOKSHOW(*target, int_no_args).repeats(3, [count = 0] () mutable { return ++count; });
+    SPOOKSHOW(*target, int_no_args).always([count = 100] () mutable { return ++count; });
+  }
+
+  const int expected[] = { 1, 2, 3, 101, 102, 103, 104 };
+  for (int value : expected)
+  {
+    EXPECT_EQ(plain.int_no_args(), value);
+    EXPECT_EQ(shared.int_no_args(), value);
+  }
+  EXPECT_NOT_FAILED();
+}
+
+TEST_F(MethodTests, ConcurrentModeSerializesStatefulFunctors)
+{
+  static const int THREAD_COUNT = 4;
+  static const int CALL_COUNT = 1000;
+
+  SPOOKSHOW(m_mock, int_no_args).enable_concurrency();
+  SPOOKSHOW(m_mock, int_no_args).always([count = 0] () mutable { return ++count; });
+
+  // every thread must see distinct results, since calls to a mutable functor are serialized
+  std::vector<std::vector<int>> results(THREAD_COUNT);
+  std::vector<std::thread> threads;
+  for (int thread = 0; thread < THREAD_COUNT; thread++)
+    threads.emplace_back([this, &results, thread] {
+        for (int idx = 0; idx < CALL_COUNT; idx++)
+          results[thread].push_back(m_mock.int_no_args());
+      });
+  for (std::thread& thread : threads)
+    thread.join();
+
+  std::vector<int> all;
+  for (const std::vector<int>& thread_results : results)
+    all.insert(all.end(), thread_results.begin(), thread_results.end());
+  std::sort(all.begin(), all.end());
+  for (int idx = 0; idx < THREAD_COUNT * CALL_COUNT; idx++)
+    EXPECT_EQ(all[idx], idx + 1);
+  EXPECT_NOT_FAILED();
+}
+
+TEST_F(MethodTests, ConcurrentModeAcceptsMoveOnlyFunctors)
+{
+  std::unique_ptr<int> value(new int(42));
+  SPOOKSHOW(m_mock, int_no_args).enable_concurrency();
+  SPOOKSHOW(m_mock, int_no_args).always([value = std::move(value)] { return *value; });
+
+  EXPECT_EQ(m_mock.int_no_args(), 42);
+  EXPECT_EQ(m_mock.int_no_args(), 42);
+  EXPECT_NOT_FAILED();
+}
+
+TEST_F(MethodTests, KeyedFunctorsAreSelectedByArgument)
+{
+  const int KEY_COUNT = 1000;
+  for (int key = 0; key < KEY_COUNT; key++)
+    SPOOKSHOW(m_mock, int_one_arg).when<0>(key, returns(key * 2));
+
+  for (int key = KEY_COUNT - 1; key >= 0; key--)
+    EXPECT_EQ(m_mock.int_one_arg(key), key * 2);
+  EXPECT_EQ(m_mock.int_one_arg(7), 14);
+  EXPECT_NOT_FAILED();
+}
+
+TEST_F(MethodTests, UnmatchedKeyedCallsFallThroughToQueue)
+{
+  SPOOKSHOW(m_mock, int_one_arg).when<0>(1, returns(10));
+  SPOOKSHOW(m_mock, int_one_arg).once(returns(20));
+
+  EXPECT_EQ(m_mock.int_one_arg(1), 10);
+  EXPECT_EQ(m_mock.int_one_arg(2), 20);
+  EXPECT_EQ(m_mock.int_one_arg(1), 10);
+  EXPECT_NOT_FAILED();
+
+  m_mock.int_one_arg(2);
+  EXPECT_FAILED();
+}
+
+TEST_F(MethodTests, KeyedFunctorsMayUseAnyArgument)
+{
+  wide_mock mock;
+  SPOOKSHOW(mock, take).when<1>("one", [] (std::unique_ptr<int> pointer, const std::string&) {
+      return *pointer + 1;
+    });
+  SPOOKSHOW(mock, take).when<1>("two", returns(2));
+
+  EXPECT_EQ(mock.take(std::make_unique<int>(40), "one"), 41);
+  EXPECT_EQ(mock.take(nullptr, "two"), 2);
+  EXPECT_NOT_FAILED();
+}
+
+TEST_F(MethodTests, RegisteringKeyAgainReplacesFunctor)
+{
+  SPOOKSHOW(m_mock, int_two_args).when<1>(5, returns(1));
+  SPOOKSHOW(m_mock, int_two_args).when<1>(5, returns(2));
+  EXPECT_EQ(m_mock.int_two_args(0, 5), 2);
+  EXPECT_NOT_FAILED();
+}
+
+TEST_F(MethodTests, ResetRemovesKeyedFunctors)
+{
+  SPOOKSHOW(m_mock, void_one_arg).when<0>(3, noops());
+  m_mock.void_one_arg(3);
+  EXPECT_NOT_FAILED();
+
+  SPOOKSHOW(m_mock, void_one_arg).reset();
+  m_mock.void_one_arg(3);
+  EXPECT_FAILED();
+}
+
+TEST_F(MethodTests, KeyedFunctorMayRegisterKeys)
+{
+  std::string label = "registered";
+  SPOOKSHOW(m_mock, int_one_arg).when<0>(0, [this, label] (int) {
+      // enough keys to make the table grow, while this functor is running
+      for (int key = 1; key < 100; key++)
+        SPOOKSHOW(m_mock, int_one_arg).when<0>(key, returns(key * 2));
+      SPOOKSHOW(m_mock, int_one_arg).when<0>(0, returns(-1));
+      return static_cast<int>(label.size());
+    });
+
+  EXPECT_EQ(m_mock.int_one_arg(0), 10);
+  EXPECT_EQ(m_mock.int_one_arg(0), -1);
+  EXPECT_EQ(m_mock.int_one_arg(50), 100);
+  EXPECT_NOT_FAILED();
+}
+
+TEST_F(MethodTests, KeyedFunctorMayResetItsOwnMethod)
+{
+  std::string label = "reset";
+  SPOOKSHOW(m_mock, int_one_arg).when<0>(3, [this, label] (int) {
+      SPOOKSHOW(m_mock, int_one_arg).reset();
+      return static_cast<int>(label.size());
+    });
+
+  EXPECT_EQ(m_mock.int_one_arg(3), 5);
+  EXPECT_NOT_FAILED();
+
+  m_mock.int_one_arg(3);
+  EXPECT_FAILED();
+}
+
+TEST_F(MethodTests, ConcurrentModeUsesKeyedFunctors)
+{
+  const int THREAD_COUNT = 4;
+  const int CALL_COUNT = 1000;
+
+  SPOOKSHOW(m_mock, int_one_arg).enable_concurrency();
+  for (int key = 0; key < THREAD_COUNT; key++)
+    SPOOKSHOW(m_mock, int_one_arg).when<0>(key, returns(key + 100));
+
+  std::atomic<int> mismatches { 0 };
+  std::vector<std::thread> threads;
+  for (int thread = 0; thread < THREAD_COUNT; thread++)
+    threads.emplace_back([this, thread, &mismatches] {
+        for (int idx = 0; idx < CALL_COUNT; idx++)
+          if (m_mock.int_one_arg(thread) != thread + 100)
+            ++mismatches;
+      });
+  for (std::thread& thread : threads)
+    thread.join();
+
+  EXPECT_EQ(mismatches, 0);
+  EXPECT_NOT_FAILED();
+}
+
+TEST_F(MethodTests, ReturnsEachValueOfRangeInOrder)
+{
+  const std::vector<int> values { 3, 1, 4, 1, 5 };
+  SPOOKSHOW(m_mock, int_no_args).once(returns_each(values));
+  for (int value : values)
+    EXPECT_EQ(m_mock.int_no_args(), value);
+  EXPECT_NOT_FAILED();
+
+  m_mock.int_no_args();
+  EXPECT_FAILED();
+}
+
+TEST_F(MethodTests, ReturnsEachMovesValuesOut)
+{
+  SPOOKSHOW(m_mock, returns_string).once(returns_each({ std::string("first"), std::string("second") }));
+  SPOOKSHOW(m_mock, returns_string).once(returns("third"));
+
+  EXPECT_EQ(m_mock.returns_string(), "first");
+  EXPECT_EQ(m_mock.returns_string(), "second");
+  EXPECT_EQ(m_mock.returns_string(), "third");
+  EXPECT_NOT_FAILED();
+}
+
+TEST_F(MethodTests, ReturnsEachChecksConditionsAndFulfillsExpectationsOnEveryCall)
+{
+  expectation exp(3);
+  SPOOKSHOW(m_mock, int_one_arg).once(returns_each({ 10, 20, 30 }))
+    .requires(arg_ne<0>(0))
+    .fulfills(exp);
+
+  EXPECT_EQ(m_mock.int_one_arg(1), 10);
+  EXPECT_EQ(m_mock.int_one_arg(2), 20);
+  EXPECT_EQ(m_mock.int_one_arg(3), 30);
+  EXPECT_TRUE(exp.is_fulfilled());
+  EXPECT_NOT_FAILED();
+}
+
+TEST_F(MethodTests, ConcurrentModeReturnsEachValueOnce)
+{
+  const int THREAD_COUNT = 4;
+  const int CALL_COUNT = 1000;
+
+  std::vector<int> values;
+  for (int idx = 0; idx < THREAD_COUNT * CALL_COUNT; idx++)
+    values.push_back(idx);
+  SPOOKSHOW(m_mock, int_no_args).enable_concurrency();
+  SPOOKSHOW(m_mock, int_no_args).once(returns_each(values));
+
+  std::vector<std::vector<int>> results(THREAD_COUNT);
+  std::vector<std::thread> threads;
+  for (int thread = 0; thread < THREAD_COUNT; thread++)
+    threads.emplace_back([this, thread, &results] {
+        for (int idx = 0; idx < CALL_COUNT; idx++)
+          results[thread].push_back(m_mock.int_no_args());
+      });
+  for (std::thread& thread : threads)
+    thread.join();
+
+  std::vector<bool> seen(values.size(), false);
+  for (const std::vector<int>& result : results)
+    for (int value : result)
+      seen[value] = true;
+  EXPECT_EQ(std::count(seen.begin(), seen.end(), false), 0);
+  EXPECT_NOT_FAILED();
+}
+
+TEST_F(MethodTests, GeneratorStreamComputesEachValue)
+{
+  int next = 0;
+  SPOOKSHOW(m_mock, int_no_args).repeats(3, returns_from([&next] { return next++ * 10; }));
+  SPOOKSHOW(m_mock, int_no_args).once(returns(-1));
+
+  EXPECT_EQ(m_mock.int_no_args(), 0);
+  EXPECT_EQ(m_mock.int_no_args(), 10);
+  EXPECT_EQ(m_mock.int_no_args(), 20);
+  EXPECT_EQ(m_mock.int_no_args(), -1);
+  EXPECT_EQ(next, 3);
+  EXPECT_NOT_FAILED();
+}
+
+TEST_F(MethodTests, IteratorStreamFailsWhenItEnds)
+{
+  const std::vector<std::string> values { "one", "two" };
+  SPOOKSHOW(m_mock, returns_string).always(returns_from(values.begin(), values.end()));
+  SPOOKSHOW(m_mock, returns_string).once(returns(std::string("three")));
+
+  EXPECT_EQ(m_mock.returns_string(), "one");
+  EXPECT_EQ(m_mock.returns_string(), "two");
+  EXPECT_NOT_FAILED();
+
+  EXPECT_EQ(m_mock.returns_string(), "");
+  EXPECT_FAILED();
+  EXPECT_NE(m_fail_message.find("return stream has ended"), std::string::npos);
+
+  // the stream was removed, so later calls go to the next entry
+  reset_failed();
+  EXPECT_EQ(m_mock.returns_string(), "three");
+  EXPECT_NOT_FAILED();
+}
+
+TEST_F(MethodTests, IteratorStreamFallsThroughToNextEntry)
+{
+  const std::vector<int> values { 1, 2 };
+  SPOOKSHOW(m_mock, int_no_args).repeats(5, returns_from(values.begin(), values.end(), stream_end::next));
+  SPOOKSHOW(m_mock, int_no_args).once(returns(3));
+
+  EXPECT_EQ(m_mock.int_no_args(), 1);
+  EXPECT_EQ(m_mock.int_no_args(), 2);
+  EXPECT_EQ(m_mock.int_no_args(), 3);
+  EXPECT_NOT_FAILED();
+
+  m_mock.int_no_args();
+  EXPECT_FAILED();
+}
+
+TEST_F(MethodTests, StreamConstructsValuesInPlace)
+{
+  // copy_counter cannot be assigned, and must not be copied on the way out of the stream
+  payload_mock mock;
+  int copies = 0;
+  SPOOKSHOW(mock, returns_counter).repeats(3, returns_from([&copies] { return copy_counter(copies); }));
+
+  for (int idx = 0; idx < 3; idx++)
+    mock.returns_counter();
+  EXPECT_NOT_FAILED();
+  EXPECT_EQ(copies, 0);
+}
+
+TEST_F(MethodTests, StreamChecksConditionsBeforePullingValue)
+{
+  expectation exp(2);
+  int next = 0;
+  SPOOKSHOW(m_mock, int_one_arg).always(returns_from([&next] { return ++next; }))
+    .requires(arg_ne<0>(0))
+    .fulfills(exp);
+
+  EXPECT_EQ(m_mock.int_one_arg(5), 1);
+  EXPECT_EQ(m_mock.int_one_arg(0), 0);
+  EXPECT_FAILED();
+  EXPECT_EQ(m_mock.int_one_arg(5), 2);
+  EXPECT_TRUE(exp.is_fulfilled());
+}
+
+TEST_F(MethodTests, ConcurrentModeStreamsEachValueOnce)
+{
+  const int THREAD_COUNT = 4;
+  const int CALL_COUNT = 1000;
+
+  int next = 0;
+  SPOOKSHOW(m_mock, int_no_args).enable_concurrency();
+  SPOOKSHOW(m_mock, int_no_args).repeats(THREAD_COUNT * CALL_COUNT, returns_from([&next] { return next++; }));
+
+  std::vector<std::vector<int>> results(THREAD_COUNT);
+  std::vector<std::thread> threads;
+  for (int thread = 0; thread < THREAD_COUNT; thread++)
+    threads.emplace_back([this, thread, &results] {
+        for (int idx = 0; idx < CALL_COUNT; idx++)
+          results[thread].push_back(m_mock.int_no_args());
+      });
+  for (std::thread& thread : threads)
+    thread.join();
+
+  std::vector<bool> seen(THREAD_COUNT * CALL_COUNT, false);
+  for (const std::vector<int>& result : results)
+    for (int value : result)
+      seen[value] = true;
+  EXPECT_EQ(std::count(seen.begin(), seen.end(), false), 0);
+  EXPECT_NOT_FAILED();
+}
+
+TEST_F(MethodTests, OnceMovesReturnValueOut)
+{
+  payload_mock mock;
+  int copies = 0;
+  SPOOKSHOW(mock, returns_counter).once(returns(copy_counter(copies)));
+  mock.returns_counter();
+  EXPECT_EQ(copies, 0);
+  EXPECT_NOT_FAILED();
+}
+
+TEST_F(MethodTests, OnceReturnsMoveOnlyValue)
+{
+  payload_mock mock;
+  SPOOKSHOW(mock, returns_unique_ptr).once(returns(std::unique_ptr<int>(new int(5))));
+  std::unique_ptr<int> result = mock.returns_unique_ptr();
+  ASSERT_TRUE(result);
+  EXPECT_EQ(*result, 5);
+  EXPECT_NOT_FAILED();
+}
+
+TEST_F(MethodTests, RepeatsCopiesSharedValueOncePerCall)
+{
+  payload_mock mock;
+  int copies = 0;
+  copy_counter counter(copies);
+  SPOOKSHOW(mock, returns_counter).repeats(3, returns(counter));
+  EXPECT_EQ(copies, 1);
+
+  for (int idx = 0; idx < 3; idx++)
+    mock.returns_counter();
+  EXPECT_EQ(copies, 4);
+  EXPECT_NOT_FAILED();
+}
+
+TEST_F(MethodTests, ReturnsRefReturnsObjectWithoutCopying)
+{
+  payload_mock mock;
+  const std::string value = "value";
+  SPOOKSHOW(mock, returns_const_ref).once(returns_ref(value));
+  SPOOKSHOW(mock, returns_const_ref).always(returns_ref(value));
+  EXPECT_EQ(&mock.returns_const_ref(), &value);
+  EXPECT_EQ(&mock.returns_const_ref(), &value);
+  EXPECT_NOT_FAILED();
+}
+
+TEST_F(MethodTests, ReturnsRefAllowsObjectToBeModified)
+{
+  payload_mock mock;
+  int value = 0;
+  SPOOKSHOW(mock, returns_ref).repeats(2, returns_ref(value));
+  mock.returns_ref() = 5;
+  EXPECT_EQ(value, 5);
+  ++mock.returns_ref();
+  EXPECT_EQ(value, 6);
+  EXPECT_NOT_FAILED();
+}
+
+TEST_F(MethodTests, ReturnsRefCopiesObjectForMethodsReturningValues)
+{
+  std::string value = "first";
+  SPOOKSHOW(m_mock, returns_string).always(returns_ref(value));
+  EXPECT_EQ(m_mock.returns_string(), "first");
+  value = "second";
+  EXPECT_EQ(m_mock.returns_string(), "second");
+  EXPECT_NOT_FAILED();
+}
+
+TEST_F(MethodTests, UnexpectedCallOfReferenceMethodReturnsDefault)
+{
+  payload_mock mock;
+  EXPECT_EQ(mock.returns_const_ref(), "");
+  EXPECT_FAILED();
+}
+
+TEST_F(MethodTests, FailedReferenceCallsDoNotShareState)
+{
+  payload_mock mock1;
+  payload_mock mock2;
+  int& first = mock1.returns_ref();
+  EXPECT_FAILED();
+  first = 5;
+
+  // each method owns its default object, which is reset by every failed call
+  EXPECT_NE(&mock2.returns_ref(), &first);
+  EXPECT_EQ(mock2.returns_ref(), 0);
+  EXPECT_EQ(mock1.returns_ref(), 0);
+}
+
+TEST_F(MethodTests, InvokeAcceptsLvalueArguments)
+{
+  payload_mock mock;
+  int copies = 0;
+  const copy_counter counter(copies);
+  const std::vector<int> values { 1, 2, 3 };
+  SPOOKSHOW(mock, by_value).once(noops());
+  SPOOKSHOW(mock, by_vector).once(returns(std::size_t(3)));
+
+  // lvalues are copied once into the by-value parameter, and moved from there
+  SPOOKSHOW(mock, by_value).invoke(counter);
+  EXPECT_EQ(copies, 1);
+  EXPECT_EQ(SPOOKSHOW(mock, by_vector).invoke(values), 3u);
+  EXPECT_NOT_FAILED();
+}
@@ -0,0 +1,183 @@
+/**
+ * @file	registry_tests.cpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2026/10/17
+ */
+
+/* -- Includes -- */
+
+#include <memory>
+#include <string>
+
+#include "test_base.hpp"
+
+/* -- Namespaces -- */
+
+using namespace spookshow;
+using namespace testing;
+
+/* -- Object Definition -- */
+
+namespace
+{
+
+  class object
+  {
+  public:
+    virtual ~object() = default;
+    virtual int value(int arg) = 0;
+    virtual void notify() = 0;
+  };
+
+  class mock : public object
+  {
+  public:
+    SPOOKSHOW_MOCK_METHOD(int, value, (int));
+    SPOOKSHOW_MOCK_METHOD(void, notify, ());
+  };
+
+}
+
+/* -- Test Cases -- */
+
+/**
+ * Unit test for the `spookshow::mock_registry` class.
+ */
+class RegistryTests : public ::spookshow::tests::TestBase
+{
+protected:
+
+  mock_registry m_registry;
+
+};
+
+TEST_F(RegistryTests, OnlyScriptedMethodsAreRegistered)
+{
+  mock mock1;
+  mock mock2;
+  EXPECT_EQ(m_registry.size(), 0u);
+
+  SPOOKSHOW(mock1, value).once(returns(1));
+  SPOOKSHOW(mock1, value).once(returns(2));
+  EXPECT_EQ(m_registry.size(), 1u);
+
+  SPOOKSHOW(mock2, notify).always(noops());
+  SPOOKSHOW(mock2, value).when<0>(5, returns(10));
+  EXPECT_EQ(m_registry.size(), 3u);
+}
+
+TEST_F(RegistryTests, ResetAllResetsEveryMethod)
+{
+  mock mock1;
+  mock mock2;
+  SPOOKSHOW(mock1, value).once(returns(1));
+  SPOOKSHOW(mock2, value).always(returns(2));
+  SPOOKSHOW(mock2, value).when<0>(5, returns(10));
+  SPOOKSHOW(mock2, notify).once(noops());
+
+  m_registry.reset_all();
+  EXPECT_EQ(m_registry.size(), 0u);
+
+  mock1.value(0);
+  EXPECT_FAILED();
+  reset_failed();
+  mock2.value(5);
+  EXPECT_FAILED();
+  reset_failed();
+  mock2.notify();
+  EXPECT_FAILED();
+}
+
+TEST_F(RegistryTests, MethodsRejoinAfterReset)
+{
+  mock mock;
+  SPOOKSHOW(mock, value).once(returns(1));
+  SPOOKSHOW(mock, value).reset();
+  EXPECT_EQ(m_registry.size(), 0u);
+
+  SPOOKSHOW(mock, value).once(returns(2));
+  EXPECT_EQ(m_registry.size(), 1u);
+  m_registry.reset_all();
+  EXPECT_EQ(m_registry.size(), 0u);
+}
+
+TEST_F(RegistryTests, DestroyedMethodsLeaveRegistry)
+{
+  mock mock1;
+  {
+    mock mock2;
+    SPOOKSHOW(mock1, value).once(returns(1));
+    SPOOKSHOW(mock2, value).once(returns(2));
+    SPOOKSHOW(mock2, notify).once(noops());
+    EXPECT_EQ(m_registry.size(), 3u);
+  }
+
+  EXPECT_EQ(m_registry.size(), 1u);
+  EXPECT_FALSE(m_registry.verify_all());
+  EXPECT_FAILED();
+}
+
+TEST_F(RegistryTests, VerifyAllSucceedsWhenFunctorsAreUsed)
+{
+  mock mock;
+  SPOOKSHOW(mock, value).once(returns(1));
+  SPOOKSHOW(mock, value).repeats(2, returns(2));
+  SPOOKSHOW(mock, value).always(returns(3));
+  SPOOKSHOW(mock, value).when<0>(5, returns(10));
+
+  mock.value(0);
+  mock.value(0);
+  mock.value(0);
+  EXPECT_TRUE(m_registry.verify_all());
+  EXPECT_NOT_FAILED();
+}
+
+TEST_F(RegistryTests, VerifyAllFailsWithUnusedFunctors)
+{
+  mock mock;
+  SPOOKSHOW(mock, value).once(returns(1));
+  SPOOKSHOW(mock, value).repeats(2, returns(2));
+  SPOOKSHOW(mock, value).always(returns(3));
+
+  mock.value(0);
+  mock.value(0);
+  EXPECT_FALSE(m_registry.verify_all());
+  EXPECT_FAILED();
+  EXPECT_NE(m_fail_message.find("Mock method has unused functors!"), std::string::npos);
+  EXPECT_NE(m_fail_message.find("1 functor was never called."), std::string::npos);
+}
+
+TEST_F(RegistryTests, InnermostRegistryIsJoined)
+{
+  mock mock1;
+  mock mock2;
+  SPOOKSHOW(mock1, value).once(returns(1));
+  {
+    mock_registry inner;
+    SPOOKSHOW(mock1, value).once(returns(2));
+    SPOOKSHOW(mock2, value).once(returns(3));
+    EXPECT_EQ(inner.size(), 1u);
+    inner.reset_all();
+  }
+
+  EXPECT_EQ(m_registry.size(), 1u);
+  EXPECT_EQ(mock1.value(0), 1);
+  EXPECT_EQ(mock1.value(0), 2);
+  EXPECT_NOT_FAILED();
+}
+
+TEST_F(RegistryTests, MethodsMayOutliveRegistry)
+{
+  std::unique_ptr<mock> mock_ptr(new mock());
+  {
+    mock_registry inner;
+    SPOOKSHOW(*mock_ptr, value).once(returns(1));
+  }
+
+  EXPECT_EQ(mock_ptr->value(0), 1);
+  SPOOKSHOW(*mock_ptr, value).once(returns(2));
+  EXPECT_EQ(m_registry.size(), 1u);
+  mock_ptr.reset();
+  EXPECT_EQ(m_registry.size(), 0u);
+  EXPECT_NOT_FAILED();
+}
@@ -0,0 +1,103 @@
+/**
+ * @file	ring_buffer_tests.cpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2026/10/16
+ */
+
+/* -- Includes -- */
+
+#include <memory>
+
+#include "test_base.hpp"
+
+/* -- Namespaces -- */
+
+using namespace spookshow;
+using namespace spookshow::internal;
+using namespace testing;
+
+/* -- Test Cases -- */
+
+/**
+ * Unit test for the `spookshow::internal::ring_buffer` class.
+ */
+class RingBufferTests : public ::spookshow::tests::TestBase
+{
+};
+
+TEST_F(RingBufferTests, DoesNotAllocateUntilUsed)
+{
+  ring_buffer<int> buffer;
+  EXPECT_TRUE(buffer.empty());
+  EXPECT_EQ(buffer.capacity(), 0u);
+}
+
+TEST_F(RingBufferTests, IsFirstInFirstOut)
+{
+  ring_buffer<int> buffer;
+  for (int idx = 0; idx < 5; idx++)
+    buffer.emplace_back(idx);
+
+  EXPECT_EQ(buffer.size(), 5u);
+  for (int idx = 0; idx < 5; idx++)
+  {
+    EXPECT_EQ(buffer.front(), idx);
+    buffer.pop_front();
+  }
+  EXPECT_TRUE(buffer.empty());
+}
+
+TEST_F(RingBufferTests, PreservesOrderWhenGrowingAfterWrapping)
+{
+  ring_buffer<int> buffer;
+  buffer.reserve(4);
+  const std::size_t capacity = buffer.capacity();
+
+  // advance the head so that the contents wrap around the end of the storage
+  for (std::size_t idx = 0; idx < capacity - 1; idx++)
+    buffer.emplace_back(-1);
+  for (std::size_t idx = 0; idx < capacity - 1; idx++)
+    buffer.pop_front();
+
+  for (int idx = 0; idx < static_cast<int>(capacity) * 3; idx++)
+    buffer.emplace_back(idx);
+  EXPECT_GT(buffer.capacity(), capacity);
+
+  for (int idx = 0; idx < static_cast<int>(capacity) * 3; idx++)
+  {
+    EXPECT_EQ(buffer[0], idx);
+    buffer.pop_front();
+  }
+}
+
+TEST_F(RingBufferTests, ReserveRoundsUpToPowerOfTwo)
+{
+  ring_buffer<int> buffer;
+  buffer.reserve(100);
+  EXPECT_EQ(buffer.capacity(), 128u);
+}
+
+TEST_F(RingBufferTests, ReferencesAreStableWithinReservedCapacity)
+{
+  ring_buffer<int> buffer;
+  buffer.reserve(64);
+  int& first = buffer.emplace_back(1);
+  for (int idx = 0; idx < 63; idx++)
+    buffer.emplace_back(idx);
+  EXPECT_EQ(&first, &buffer.front());
+}
+
+TEST_F(RingBufferTests, ClearDestroysElementsAndKeepsStorage)
+{
+  auto token = std::make_shared<int>(0);
+  ring_buffer<std::shared_ptr<int>> buffer;
+  for (int idx = 0; idx < 10; idx++)
+    buffer.emplace_back(token);
+  EXPECT_EQ(token.use_count(), 11);
+
+  const std::size_t capacity = buffer.capacity();
+  buffer.clear();
+  EXPECT_EQ(token.use_count(), 1);
+  EXPECT_TRUE(buffer.empty());
+  EXPECT_EQ(buffer.capacity(), capacity);
+}
@@ -0,0 +1,102 @@
+/**
+ * @file	segmented_queue_tests.cpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2026/10/17
+ */
+
+/* -- Includes -- */
+
+#include <memory>
+#include <vector>
+
+#include "test_base.hpp"
+
+/* -- Namespaces -- */
+
+using namespace spookshow;
+using namespace spookshow::internal;
+using namespace testing;
+
+/* -- Test Cases -- */
+
+/**
+ * Unit test for the `spookshow::internal::segmented_queue` class.
+ */
+class SegmentedQueueTests : public ::spookshow::tests::TestBase
+{
+};
+
+TEST_F(SegmentedQueueTests, IsFirstInFirstOut)
+{
+  segmented_queue<int> queue;
+  EXPECT_TRUE(queue.empty());
+  for (int idx = 0; idx < 1000; idx++)
+    queue.emplace_back(idx);
+
+  EXPECT_EQ(queue.size(), 1000u);
+  for (int idx = 0; idx < 1000; idx++)
+  {
+    EXPECT_EQ(queue.front(), idx);
+    queue.pop_front();
+  }
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST_F(SegmentedQueueTests, ElementsNeverMove)
+{
+  segmented_queue<int> queue;
+  std::vector<int*> addresses;
+  for (int idx = 0; idx < 1000; idx++)
+    addresses.push_back(&queue.emplace_back(idx));
+
+  for (int idx = 0; idx < 1000; idx++)
+  {
+    EXPECT_EQ(&queue.front(), addresses[idx]);
+    EXPECT_EQ(*addresses[idx], idx);
+    queue.pop_front();
+  }
+}
+
+TEST_F(SegmentedQueueTests, IteratesFromFrontToBack)
+{
+  segmented_queue<int> queue;
+  for (int idx = 0; idx < 100; idx++)
+    queue.emplace_back(idx);
+  for (int idx = 0; idx < 10; idx++)
+    queue.pop_front();
+
+  int expected = 10;
+  for (int value : queue)
+    EXPECT_EQ(value, expected++);
+  EXPECT_EQ(expected, 100);
+}
+
+TEST_F(SegmentedQueueTests, ReusesStorageWhenDrained)
+{
+  segmented_queue<int> queue;
+  for (int idx = 0; idx < 5; idx++)
+    queue.emplace_back(idx);
+  const int* first = &queue.front();
+  queue.clear();
+
+  // with everything popped, the queue starts again at the front of its first block
+  EXPECT_EQ(&queue.emplace_back(0), first);
+}
+
+TEST_F(SegmentedQueueTests, ClearDestroysElements)
+{
+  auto token = std::make_shared<int>(0);
+  {
+    segmented_queue<std::shared_ptr<int>> queue;
+    for (int idx = 0; idx < 10; idx++)
+      queue.emplace_back(token);
+    EXPECT_EQ(token.use_count(), 11);
+
+    queue.clear();
+    EXPECT_EQ(token.use_count(), 1);
+    EXPECT_TRUE(queue.empty());
+
+    queue.emplace_back(token);
+  }
+  EXPECT_EQ(token.use_count(), 1);
+}
@@ -0,0 +1,267 @@
+/**
+ * @file	trace_tests.cpp
+ * @author	Chris Vig (chris@invictus.so)
+ * @date	2026/10/16
+ */
+
+/* -- Includes -- */
+
+#include <cstdio>
+#include <string>
+
+#include "test_base.hpp"
+
+/* -- Namespaces -- */
+
+using namespace spookshow;
+using namespace testing;
+
+/* -- Object Definition -- */
+
+namespace
+{
+
+  enum class mode { idle, running, stopped };
+
+  class object
+  {
+  public:
+    virtual ~object() = default;
+    virtual int next(int step) { return (m_value += step); }
+    virtual double scale(double value) { return value * 2.5; }
+    virtual std::string describe(const std::string& prefix, mode mode) { return prefix + ":" + std::to_string(static_cast<int>(mode)); }
+    virtual void reset() { m_value = 0; }
+    virtual bool ready() const { return true; }
+  private:
+    int m_value { 0 };
+  };
+
+  class mock : public object
+  {
+  public:
+    SPOOKSHOW_MOCK_METHOD(int, next, (int));
+    SPOOKSHOW_MOCK_METHOD(double, scale, (double));
+    SPOOKSHOW_MOCK_METHOD(std::string, describe, (const std::string&, mode));
+    SPOOKSHOW_MOCK_METHOD(void, reset, ());
+    SPOOKSHOW_MOCK_METHOD(bool, ready, (), (const));
+  };
+
+  /**
+   * Returns the size of a file in bytes.
+   */
+  long file_size(const std::string& path)
+  {
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    std::fseek(file, 0, SEEK_END);
+    const long size = std::ftell(file);
+    std::fclose(file);
+    return size;
+  }
+
+}
+
+/* -- Test Cases -- */
+
+/**
+ * Unit test for the `spookshow::trace_recorder` and `spookshow::trace_replayer` classes.
+ */
+class TraceTests : public ::spookshow::tests::TestBase
+{
+protected:
+
+  const std::string m_path { ::testing::TempDir() + "spookshow_trace_tests.trace" };
+  object m_real;
+
+  virtual void TearDown() override
+  {
+    std::remove(m_path.c_str());
+    TestBase::TearDown();
+  }
+
+  /**
+   * Records all methods of `recording` into the trace, forwarding them to `m_real`.
+   */
+  void record_all(trace_recorder& recorder, mock& recording)
+  {
+    recorder.record(SPOOKSHOW(recording, next), [this] (int step) { return m_real.next(step); });
+    recorder.record(SPOOKSHOW(recording, scale), [this] (double value) { return m_real.scale(value); });
+    recorder.record(SPOOKSHOW(recording, describe), [this] (const std::string& prefix, mode mode) {
+        return m_real.describe(prefix, mode);
+      });
+    recorder.record(SPOOKSHOW(recording, reset), [this] { m_real.reset(); });
+    recorder.record(SPOOKSHOW(recording, ready), [this] { return m_real.ready(); });
+  }
+
+  /**
+   * Replays all methods of `replaying` from the trace.
+   */
+  void replay_all(trace_replayer& replayer, mock& replaying)
+  {
+    replayer.replay(SPOOKSHOW(replaying, next));
+    replayer.replay(SPOOKSHOW(replaying, scale));
+    replayer.replay(SPOOKSHOW(replaying, describe));
+    replayer.replay(SPOOKSHOW(replaying, reset));
+    replayer.replay(SPOOKSHOW(replaying, ready));
+  }
+
+};
+
+TEST_F(TraceTests, RecordedCallsReachTheTarget)
+{
+  mock recording;
+  trace_recorder recorder(m_path);
+  record_all(recorder, recording);
+
+  EXPECT_EQ(recording.next(3), 3);
+  EXPECT_EQ(recording.next(4), 7);
+  EXPECT_EQ(recording.scale(2.0), 5.0);
+  EXPECT_EQ(recorder.calls(), 3u);
+  EXPECT_NOT_FAILED();
+}
+
+TEST_F(TraceTests, ReplayReturnsRecordedValues)
+{
+  {
+    mock recording;
+    trace_recorder recorder(m_path);
+    record_all(recorder, recording);
+    recording.next(3);
+    recording.scale(-1.25);
+    recording.describe("motor", mode::running);
+    recording.next(-10);
+    recording.reset();
+    recording.ready();
+    recording.next(1000000);
+  }
+
+  mock replaying;
+  trace_replayer replayer(m_path);
+  replay_all(replayer, replaying);
+  EXPECT_EQ(replaying.next(3), 3);
+  EXPECT_EQ(replaying.scale(-1.25), -3.125);
+  EXPECT_EQ(replaying.describe("motor", mode::running), "motor:1");
+  EXPECT_EQ(replaying.next(-10), -7);
+  replaying.reset();
+  EXPECT_TRUE(replaying.ready());
+  EXPECT_EQ(replaying.next(1000000), 1000000);
+  EXPECT_NOT_FAILED();
+}
+
+TEST_F(TraceTests, MethodsReplayIndependently)
+{
+  {
+    mock recording;
+    trace_recorder recorder(m_path);
+    record_all(recorder, recording);
+    recording.next(1);
+    recording.scale(1.0);
+    recording.next(2);
+    recording.scale(2.0);
+  }
+
+  mock replaying;
+  trace_replayer replayer(m_path);
+  replay_all(replayer, replaying);
+  EXPECT_EQ(replaying.scale(1.0), 2.5);
+  EXPECT_EQ(replaying.scale(2.0), 5.0);
+  EXPECT_EQ(replaying.next(1), 1);
+  EXPECT_EQ(replaying.next(2), 3);
+  EXPECT_NOT_FAILED();
+}
+
+TEST_F(TraceTests, ReplayFailsOnDifferentArguments)
+{
+  {
+    mock recording;
+    trace_recorder recorder(m_path);
+    record_all(recorder, recording);
+    recording.next(1);
+  }
+
+  mock replaying;
+  trace_replayer replayer(m_path);
+  replay_all(replayer, replaying);
+  replaying.next(2);
+  EXPECT_FAILED();
+  EXPECT_NE(m_fail_message.find("unexpected arguments"), std::string::npos);
+}
+
+TEST_F(TraceTests, ReplayFailsAfterLastRecordedCall)
+{
+  {
+    mock recording;
+    trace_recorder recorder(m_path);
+    record_all(recorder, recording);
+    recording.next(1);
+  }
+
+  mock replaying;
+  trace_replayer replayer(m_path);
+  replay_all(replayer, replaying);
+  replaying.next(1);
+  EXPECT_NOT_FAILED();
+  replaying.next(1);
+  EXPECT_FAILED();
+}
+
+TEST_F(TraceTests, MethodsCanBeNamedExplicitly)
+{
+  {
+    mock recording;
+    trace_recorder recorder(m_path);
+    recorder.record("first", SPOOKSHOW(recording, next), [] (int step) { return step + 1; });
+    recorder.record("second", SPOOKSHOW(recording, next), [] (int step) { return step + 2; });
+    recording.next(10);
+  }
+
+  mock replaying;
+  trace_replayer replayer(m_path);
+  replayer.replay("first", SPOOKSHOW(replaying, next));
+  EXPECT_EQ(replaying.next(10), 11);
+  EXPECT_NOT_FAILED();
+}
+
+TEST_F(TraceTests, SlowlyChangingValuesAreEncodedCompactly)
+{
+  const int CALL_COUNT = 10000;
+  {
+    mock recording;
+    trace_recorder recorder(m_path);
+    record_all(recorder, recording);
+    for (int idx = 0; idx < CALL_COUNT; idx++)
+      recording.next(idx % 50);
+  }
+
+  // one byte each for the tag, the length, the argument and the result
+  EXPECT_LE(file_size(m_path), 200 + 5 * CALL_COUNT);
+
+  mock replaying;
+  trace_replayer replayer(m_path);
+  replay_all(replayer, replaying);
+  int expected = 0;
+  for (int idx = 0; idx < CALL_COUNT; idx++)
+    ASSERT_EQ(replaying.next(idx % 50), (expected += idx % 50));
+  EXPECT_NOT_FAILED();
+}
+
+TEST_F(TraceTests, NearbyFloatingPointValuesAreEncodedCompactly)
+{
+  const int CALL_COUNT = 10000;
+  {
+    mock recording;
+    trace_recorder recorder(m_path);
+    record_all(recorder, recording);
+    for (int idx = 0; idx < CALL_COUNT; idx++)
+      recording.scale(100.0 + idx * 0.001);
+  }
+
+  // only the low mantissa bytes of each value change from call to call
+  EXPECT_LE(file_size(m_path), 200 + 16 * CALL_COUNT);
+
+  mock replaying;
+  trace_replayer replayer(m_path);
+  replay_all(replayer, replaying);
+  for (int idx = 0; idx < CALL_COUNT; idx++)
+    ASSERT_EQ(replaying.scale(100.0 + idx * 0.001), (100.0 + idx * 0.001) * 2.5);
+  EXPECT_NOT_FAILED();
+}